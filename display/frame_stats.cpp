@@ -0,0 +1,115 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This file holds the source code for the FrameStats class
+ */
+
+#include "frame_stats.hpp"
+#include "../personal_utilities/douglbre_util.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Constructor
+// <window> is the number of most recent samples of each series that are kept
+FrameStats::FrameStats(unsigned int window) {
+    this->window = window > 0 ? window : 1;
+}
+
+// The id of the series called <name>, it is made the first time it is asked for
+unsigned int FrameStats::getSeries(const std::string &name) {
+    for(unsigned int i = 0; i < series.size(); i++) {
+        if(series[i].name == name) {
+            return i;
+        }
+    }
+    Series s;
+    s.name = name;
+    s.samples.reserve(window);
+    s.next = 0;
+    series.push_back(s);
+    return series.size() - 1;
+}
+
+// Add a sample to a series, pushing out its oldest sample once the window is full
+// <id> is from getSeries
+// <seconds> is the time taken
+void FrameStats::add(unsigned int id, double seconds) {
+    Series &s = series[id];
+    if(s.samples.size() < window) {
+        s.samples.push_back(seconds);
+    } else {
+        s.samples[s.next] = seconds;
+    }
+    s.next = (s.next + 1) % window;
+}
+
+// Value at fraction <p> of the way through <sorted>, the nearest rank so it is always a sample that happened
+double FrameStats::percentile(std::vector<double> &sorted, double p) {
+    if(sorted.empty()) {
+        return 0;
+    }
+    unsigned int rank = (unsigned int) std::ceil(p * sorted.size());
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+// Percentiles of every sample in the window of a series
+FrameStats::Summary FrameStats::summarize(unsigned int id) {
+    const Series &s = series[id];
+    scratch.assign(s.samples.begin(), s.samples.end());
+    std::sort(scratch.begin(), scratch.end());
+    Summary summary;
+    summary.p50 = percentile(scratch, 0.50);
+    summary.p95 = percentile(scratch, 0.95);
+    summary.p99 = percentile(scratch, 0.99);
+    summary.max = scratch.empty() ? 0 : scratch.back();
+    summary.count = scratch.size();
+    return summary;
+}
+
+// Copy up to the last <n> samples of a series into <out>, oldest first, returns how many there were
+unsigned int FrameStats::recent(unsigned int id, unsigned int n, std::vector<double>* out) {
+    const Series &s = series[id];
+    unsigned int size = s.samples.size();
+    n = std::min(n, size);
+    out->clear();
+    // Before the window fills the oldest sample is at the front, after that it is at next
+    unsigned int oldest = size < window ? 0 : s.next;
+    for(unsigned int k = size - n; k < size; k++) {
+        out->push_back(s.samples[(oldest + k) % size]);
+    }
+    return n;
+}
+
+// Print the percentiles of a series in milliseconds on sideline <j> of <screen>
+void FrameStats::printSummary(Screen* screen, int j, unsigned int id) {
+    Summary summary = summarize(id);
+    char line[128];
+    std::snprintf(line, sizeof(line), " %-7s p50 %6.2f  p95 %6.2f  p99 %6.2f  max %6.2f ms",
+                  (series[id].name + ":").c_str(), summary.p50 * 1000, summary.p95 * 1000,
+                  summary.p99 * 1000, summary.max * 1000);
+    screen->printValue(j, line);
+}
+
+// Print a bar graph of the last <samples> samples of a series on sidelines <j> to <j> + <height>, with a title line
+// above it that gives the largest sample, which is the top of the graph.  It grows from the left until the window has
+// that many samples.
+void FrameStats::printGraph(Screen* screen, int j, unsigned int id, int samples, int height) {
+    unsigned int n = recent(id, samples, &scratch);
+    double largest = n > 0 ? *std::max_element(scratch.begin(), scratch.end()) : 0;
+    char title[128];
+    std::snprintf(title, sizeof(title), " %s, last %u frames, top %.2f ms", series[id].name.c_str(), n,
+                  largest * 1000);
+    screen->printValue(j, title);
+    if(n == 0) {
+        return;
+    }
+
+    std::string graph = douglbre::visual::compressed_bar_graph(scratch.data(), n, height, 1, '|', '.');
+    std::size_t rows = 0;
+    std::string* lines = douglbre::util::split_string(graph, "\n", &rows);
+    for(std::size_t r = 0; r < rows; r++) {
+        screen->printValue(j + 1 + r, " " + lines[r]);
+    }
+    delete [] lines;
+}
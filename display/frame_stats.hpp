@@ -0,0 +1,59 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This file holds the header for the FrameStats class
+ */
+
+#ifndef FINAL_PROJECT_FRAME_STATS_HPP
+#define FINAL_PROJECT_FRAME_STATS_HPP
+
+#include <string>
+#include <vector>
+#include "screen.hpp"
+
+// FrameStats keeps the last window of timings for each named series, such as the step or render time of a frame,
+// and summarizes them by percentile.  Stutter shows up in the tail of the timings and not in the average, so the
+// summaries are the median, the 95th and 99th percentile and the max.  The summaries and a bar graph of the most
+// recent timings can be printed in the sidelines of a Screen.
+class FrameStats {
+public:
+    // Percentiles of a series over its window, in seconds
+    struct Summary {
+        double p50;
+        double p95;
+        double p99;
+        double max;
+        unsigned int count;
+    };
+
+protected:
+    struct Series {
+        std::string name;
+        std::vector<double> samples;    // Ring of the last window samples, next is the oldest once it is full
+        unsigned int next;
+    };
+
+    unsigned int window;
+    std::vector<Series> series;
+    // Reused for sorting and graphing so summaries do not allocate every frame
+    std::vector<double> scratch;
+
+    static double percentile(std::vector<double> &sorted, double p);
+
+public:
+
+    FrameStats(unsigned int window = 120);
+
+    unsigned int getWindow() { return window; }
+
+    unsigned int getSeries(const std::string &name);
+    const std::string& getName(unsigned int id) { return series[id].name; }
+    void add(unsigned int id, double seconds);
+    Summary summarize(unsigned int id);
+    unsigned int recent(unsigned int id, unsigned int n, std::vector<double>* out);
+
+    void printSummary(Screen* screen, int j, unsigned int id);
+    void printGraph(Screen* screen, int j, unsigned int id, int samples, int height);
+};
+
+#endif //FINAL_PROJECT_FRAME_STATS_HPP
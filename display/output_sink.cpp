@@ -0,0 +1,156 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This file holds the source code for the output sinks a screen can write its frames to
+ */
+
+#include "output_sink.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+constexpr char RecorderSink::MAGIC[5];
+
+// Send the frame to the terminal in one write, anything still sitting in std::cout goes first
+void TerminalSink::write(const char * data, size_t length) {
+    std::cout << std::flush;
+    while(length > 0) {
+        ssize_t written = ::write(STDOUT_FILENO, data, length);
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        data += written;
+        length -= written;
+    }
+}
+
+// Count the frame and keep its bytes if asked to
+void MemorySink::write(const char * data, size_t length) {
+    if(keep) {
+        bytes.insert(bytes.end(), data, data + length);
+    }
+    frames++;
+    total += length;
+}
+
+// Forget every frame written so far
+void MemorySink::clear() {
+    bytes.clear();
+    frames = 0;
+    total = 0;
+}
+
+// Constructor, opens the recording
+// <path> is the file the frames are recorded to, it is replaced if it exists
+// <forward> is another sink every frame is also written to, such as the terminal, or nullptr
+RecorderSink::RecorderSink(const std::string &path, OutputSink* forward) : forward(forward) {
+    file.open(path.c_str(), std::ios::binary | std::ios::trunc);
+    if(!file) {
+        throw std::runtime_error("Could not open recording " + path);
+    }
+}
+
+// Write a number seven bits at a time, the high bit of a byte is set when more bytes follow
+void RecorderSink::putVarint(std::ostream &out, unsigned long long n) {
+    do {
+        char b = n & 0x7f;
+        n >>= 7;
+        if(n > 0) {
+            b |= 0x80;
+        }
+        out.put(b);
+    } while(n > 0);
+}
+
+// Read a number written by putVarint, false at the end of the file
+bool RecorderSink::getVarint(std::istream &in, unsigned long long* n) {
+    *n = 0;
+    for(int shift = 0; shift < 64; shift += 7) {
+        int b = in.get();
+        if(b == EOF) {
+            if(shift == 0) {
+                return false;
+            }
+            throw std::runtime_error("Recording ends in the middle of a frame");
+        }
+        *n |= (unsigned long long)(b & 0x7f) << shift;
+        if(!(b & 0x80)) {
+            return true;
+        }
+    }
+    throw std::runtime_error("Recording has a bad frame length");
+}
+
+// Write the header of the recording
+void RecorderSink::begin(int width, int height) {
+    file.write(MAGIC, 4);
+    putVarint(file, width);
+    putVarint(file, height);
+    last = std::chrono::steady_clock::now();
+    if(forward != nullptr) {
+        forward->begin(width, height);
+    }
+}
+
+// Record a frame
+void RecorderSink::write(const char * data, size_t length) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    putVarint(file, std::chrono::duration_cast<std::chrono::microseconds>(now - last).count());
+    last = now;
+    putVarint(file, length);
+    file.write(data, length);
+    file.flush();
+    if(forward != nullptr) {
+        forward->write(data, length);
+    }
+}
+
+// Play a recording back into a sink, returns the number of frames played
+// <path> is the recording
+// <sink> is where the frames are written, such as a TerminalSink to watch it again
+// <real_time> waits between frames as long as the recording did, otherwise it is played as fast as possible
+// <width> and <height> are set to the size of the recorded screen when not nullptr
+unsigned int RecorderSink::replay(const std::string &path, OutputSink* sink, bool real_time,
+                                  int* width, int* height) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if(!in) {
+        throw std::runtime_error("Could not open recording " + path);
+    }
+    char magic[4];
+    unsigned long long w, h;
+    if(!in.read(magic, 4) || std::memcmp(magic, MAGIC, 4) != 0 || !getVarint(in, &w) || !getVarint(in, &h)) {
+        throw std::runtime_error(path + " is not a screen recording");
+    }
+    if(width != nullptr) {
+        *width = w;
+    }
+    if(height != nullptr) {
+        *height = h;
+    }
+    sink->begin(w, h);
+
+    std::vector<char> frame;
+    unsigned long long wait, length;
+    unsigned int frames = 0;
+    while(getVarint(in, &wait)) {
+        if(!getVarint(in, &length)) {
+            throw std::runtime_error("Recording ends in the middle of a frame");
+        }
+        frame.resize(length);
+        if(!in.read(frame.data(), length)) {
+            throw std::runtime_error("Recording ends in the middle of a frame");
+        }
+        if(real_time) {
+            std::this_thread::sleep_for(std::chrono::microseconds(wait));
+        }
+        sink->write(frame.data(), frame.size());
+        frames++;
+    }
+    return frames;
+}
@@ -0,0 +1,74 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This file holds the header for the output sinks a screen can write its frames to
+ */
+
+#ifndef FINAL_PROJECT_OUTPUT_SINK_HPP
+#define FINAL_PROJECT_OUTPUT_SINK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// OutputSink is where a Screen sends the bytes of each frame it displays.  A frame is handed over in one call, so
+// a sink can send it with a single write, keep it in memory or record it.
+class OutputSink {
+public:
+    virtual ~OutputSink() {}
+
+    // Called once by the screen before anything is written
+    virtual void begin(int width, int height) {}
+    virtual void write(const char * data, size_t length) = 0;
+};
+
+// Writes frames straight to the terminal on standard out
+class TerminalSink : public OutputSink {
+public:
+    void write(const char * data, size_t length);
+};
+
+// Keeps frames in memory instead of showing them, for running without a terminal
+class MemorySink : public OutputSink {
+protected:
+    std::vector<char> bytes;
+    bool keep;
+    unsigned int frames = 0;
+    size_t total = 0;
+public:
+    MemorySink(bool keep = true) : keep(keep) {}
+
+    void write(const char * data, size_t length);
+
+    const std::vector<char>& getBytes() { return bytes; }
+    unsigned int getFrames() { return frames; }
+    size_t getTotalBytes() { return total; }
+    void clear();
+};
+
+// Records every frame to a file so a run can be played back later with RecorderSink::replay.  The file starts with
+// a magic number and the screen's width and height, then each frame is the microseconds since the last frame and
+// its length as variable length integers followed by the frame's bytes.
+class RecorderSink : public OutputSink {
+protected:
+    std::ofstream file;
+    OutputSink* forward;
+    std::chrono::steady_clock::time_point last;
+
+    static void putVarint(std::ostream &out, unsigned long long n);
+    static bool getVarint(std::istream &in, unsigned long long* n);
+public:
+    constexpr static char MAGIC[5] = "SCR1";
+
+    RecorderSink(const std::string &path, OutputSink* forward = nullptr);
+
+    void begin(int width, int height);
+    void write(const char * data, size_t length);
+
+    static unsigned int replay(const std::string &path, OutputSink* sink, bool real_time = false,
+                               int* width = nullptr, int* height = nullptr);
+};
+
+#endif //FINAL_PROJECT_OUTPUT_SINK_HPP
@@ -23,11 +23,11 @@ public:
         this->c = c;
     }
     // Returns the column
-    int getI() { return i; }
+    int getI() const { return i; }
     // Returns the row
-    int getJ() { return j; }
+    int getJ() const { return j; }
     // Returns the char being printed
-    char getChar() { return c; }
+    char getChar() const { return c; }
     // Updates the char that will be printed
     void setChar(char c) { this->c = c; }
     // Checks equality with another Pixel by ixj only not the char
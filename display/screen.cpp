@@ -5,197 +5,450 @@
  */
 
 #include "screen.hpp"
+#include "../trace.hpp"
 #include <algorithm>
 #include <cmath>
 #include <chrono>
+#include <cstring>
+
+constexpr char Screen::EMPTY;
 
 // Default constructor, the pixel width and height are the defining factors of a screen
-Screen::Screen(int width, int height) {
+// <sink> is where the frames are written, it is not owned by the screen.  When nullptr the screen writes to the
+// terminal.
+Screen::Screen(int width, int height, OutputSink* sink) {
     this->width = width;
     this->height = height;
-    previous_frame = nullptr;
-    frame = nullptr;
-    // Initialize both the frame and the previous frame by calling newFrame twice
-    newFrame();
-    newFrame();
+    // Both frames start out empty and are reused for the life of the screen
+    previous_frame.assign(width * height, EMPTY);
+    frame.assign(width * height, EMPTY);
+    dirty_min.assign(height, width);
+    dirty_max.assign(height, -1);
+    previous_dirty_min.assign(height, width);
+    previous_dirty_max.assign(height, -1);
+    background.assign(width * height, EMPTY);
+    background_min.assign(height, width);
+    background_max.assign(height, -1);
+    // Enough room for a full frame with a cursor move before every char, so a frame never has to grow it
+    output.reserve((width + 2) * (height + 2) * 8);
+
+    owns_sink = sink == nullptr;
+    this->sink = owns_sink ? new TerminalSink() : sink;
+    this->sink->begin(width, height);
 }
 
-// Deconstructor, free up any memory and reset the cursor position
+// Deconstructor, reset the cursor position
 Screen::~Screen() {
     // Move the cursor back to its normal location
     moveCursorVertically(-2);
-    // Free up the memory from frame and previous_frame
-    delete frame;
-    delete previous_frame;
+    flushOutput();
+    if(owns_sink) {
+        delete sink;
+    }
+}
+
+// Add a char to the output
+void Screen::put(char c) {
+    output.push_back(c);
+    cursor_i++;
+}
+
+// Add a positive number to the output as text
+void Screen::putNumber(int n) {
+    char digits[12];
+    int d = 0;
+    do {
+        digits[d++] = '0' + (n % 10);
+        n /= 10;
+    } while(n > 0);
+    while(d > 0) {
+        output.push_back(digits[--d]);
+    }
+}
+
+// Add a string to the output
+void Screen::putString(const std::string &s) {
+    output.insert(output.end(), s.begin(), s.end());
+    cursor_i += s.length();
+}
+
+// Send everything in the output to the sink in one write
+void Screen::flushOutput() {
+    Trace::Scope trace("write");
+    if(!output.empty()) {
+        sink->write(output.data(), output.size());
+    }
+    output.clear();
 }
 
 // Moves the cursor vertically by j, when positive it goes up and negative goes down
 void Screen::moveCursorVertically(int j) {
     if(j > 0) {
         // ASCII control sequence for upwards
-        std::cout << "\033[" << j << "A" << std::flush;
+        output.push_back('\033');
+        output.push_back('[');
+        putNumber(j);
+        output.push_back('A');
     } else if(j < 0) {
         // ASCII control sequence for downwards
-        std::cout << "\033[" << -j << "B" << std::flush;
+        output.push_back('\033');
+        output.push_back('[');
+        putNumber(-j);
+        output.push_back('B');
     }
+    cursor_j += j;
 }
 
 // Moves the cursor horizontally by i, when positive it goes to the right and negative goes to the left
 void Screen::moveCursorHorizontally(int i) {
     if(i > 0) {
         // ASCII control sequence for rightward movement
-        std::cout << "\033[" << i << "C" << std::flush;
+        output.push_back('\033');
+        output.push_back('[');
+        putNumber(i);
+        output.push_back('C');
     } else if (i < 0) {
-        // ASCII control sequence for leftward movement=
-        std::cout << "\033[" << -i << "D" << std::flush;
+        // ASCII control sequence for leftward movement
+        output.push_back('\033');
+        output.push_back('[');
+        putNumber(-i);
+        output.push_back('D');
     }
+    cursor_i += i;
 }
 
-// This handles the creation of a new frame and the deletion of the prior previous one
+// Number of digits in a positive number
+static int digits(int n) {
+    int d = 1;
+    while(n >= 10) {
+        n /= 10;
+        d++;
+    }
+    return d;
+}
+
+// Length of the control sequence for a relative move of <n>
+static int relativeMoveLength(int n) {
+    return n == 0 ? 0 : 3 + digits(n < 0 ? -n : n);
+}
+
+// Char that is on the terminal at column <i> and row <j>, the frame is the same as the terminal everywhere except
+// for the spans that have not been printed yet.  Columns -1 and width are the border.
+char Screen::shownChar(int i, int j) {
+    if(i < 0 || i >= width) {
+        return '|';
+    }
+    return frame[i + (j * width)];
+}
+
+// Cost in bytes of moving horizontally from column <from> to column <i> on row <j>, and how it is done
+int Screen::planHorizontal(int from, int i, int j, HorizontalMove* move) {
+    if(from == i) {
+        *move = H_NONE;
+        return 0;
+    }
+    *move = H_RELATIVE;
+    int best = relativeMoveLength(i - from);
+    // Absolute column, the left border is in the first terminal column
+    int cost = 3 + digits(i + 2);
+    if(cost < best) {
+        *move = H_COLUMN;
+        best = cost;
+    }
+    // Overprinting needs to know every char that is passed over, which is only true inside of the screen and borders
+    bool printable = j >= 0 && j < height && i <= width;
+    if(printable && from >= -1 && from < i && i - from < best) {
+        *move = H_OVERPRINT;
+        best = i - from;
+    }
+    // Carriage return to the left border and then overprint or move right from there
+    if(printable && 1 + (i + 1) < best) {
+        *move = H_RETURN_OVERPRINT;
+        best = 1 + (i + 1);
+    }
+    cost = 1 + relativeMoveLength(i + 1);
+    if(cost < best) {
+        *move = H_RETURN_RELATIVE;
+        best = cost;
+    }
+    return best;
+}
+
+// Moves the cursor to column <i> and row <j> of the screen with as few bytes as possible.  Every way to get there is
+// priced, a relative or newline move between rows followed by a relative move, an absolute column, a carriage return
+// or overprinting the chars in the way, or a single absolute move when the screen's position is known.
+void Screen::moveCursorTo(int i, int j) {
+    if(i == cursor_i && j == cursor_j) {
+        return;
+    }
+
+    int best = -1;
+    bool absolute = false;
+    bool newlines = false;
+    HorizontalMove horizontal = H_NONE;
+
+    // Relative vertical move, the column stays the same
+    HorizontalMove move;
+    int cost = relativeMoveLength(j - cursor_j) + planHorizontal(cursor_i, i, j, &move);
+    best = cost;
+    horizontal = move;
+
+    // Carriage return and newlines to go down, leaves the cursor on the left border
+    if(j < cursor_j) {
+        cost = 1 + (cursor_j - j) + planHorizontal(-1, i, j, &move);
+        if(cost < best) {
+            best = cost;
+            newlines = true;
+            horizontal = move;
+        }
+    }
+
+    // The top border is on the first terminal row and the left border in the first column
+    int row = height - j + 1;
+    int col = i + 2;
+    if(addressing == ABSOLUTE && 4 + digits(row) + digits(col) < best) {
+        absolute = true;
+    }
+
+    if(absolute) {
+        output.push_back('\033');
+        output.push_back('[');
+        putNumber(row);
+        output.push_back(';');
+        putNumber(col);
+        output.push_back('H');
+        cursor_i = i;
+        cursor_j = j;
+        return;
+    }
+
+    if(newlines) {
+        output.push_back('\r');
+        output.insert(output.end(), cursor_j - j, '\n');
+        cursor_i = -1;
+        cursor_j = j;
+    } else {
+        moveCursorVertically(j - cursor_j);
+    }
+
+    switch (horizontal) {
+        case H_NONE:
+            break;
+        case H_RELATIVE:
+            moveCursorHorizontally(i - cursor_i);
+            break;
+        case H_COLUMN:
+            output.push_back('\033');
+            output.push_back('[');
+            putNumber(col);
+            output.push_back('G');
+            cursor_i = i;
+            break;
+        case H_RETURN_RELATIVE:
+            output.push_back('\r');
+            cursor_i = -1;
+            moveCursorHorizontally(i - cursor_i);
+            break;
+        case H_RETURN_OVERPRINT:
+            output.push_back('\r');
+            cursor_i = -1;
+            // Fall through to print from the left border
+        case H_OVERPRINT:
+            while(cursor_i < i) {
+                put(shownChar(cursor_i, j));
+            }
+            break;
+    }
+}
+
+// This makes the frame that was just displayed the previous frame, and starts the other one to be drawn on next
+// from the background
 void Screen::newFrame() {
-    // Delete the old previous frame
-    delete previous_frame;
-    // Set the current frame to the previous frame
-    previous_frame = frame;
-    // Create a new frame
-    frame = new std::vector<Pixel>();
-    // Fill the new frame with default (empty) pixels
+    frame.swap(previous_frame);
+    dirty_min.swap(previous_dirty_min);
+    dirty_max.swap(previous_dirty_max);
+    // The frame from two frames ago only has chars inside of its dirty columns, so copying the background over those
+    // and the background's own columns leaves the frame the same as the background
     for(int j = 0; j < height; j++) {
-        for(int i = 0; i < width; i++) {
-            Pixel p(i,j);
-            frame->push_back(p);
+        int lo = std::min(dirty_min[j], background_min[j]);
+        int hi = std::max(dirty_max[j], background_max[j]);
+        if(lo <= hi) {
+            std::memcpy(&frame[(j * width) + lo], &background[(j * width) + lo], hi - lo + 1);
         }
+        dirty_min[j] = background_min[j];
+        dirty_max[j] = background_max[j];
+    }
+}
+
+// Set the chars that frames start from, everything else is drawn on top of them.  The current frame is started
+// again from the new background, so this has to be called before anything else is drawn in a frame.
+// <pixels> are the chars of the background, pixels outside of the screen are left out
+// <key> names <pixels>, while it stays the same the background is not built again
+void Screen::setBackground(const std::vector<Pixel> &pixels, unsigned long key) {
+    if(key == background_key) {
+        return;
+    }
+    background_key = key;
+
+    std::fill(background.begin(), background.end(), EMPTY);
+    std::fill(background_min.begin(), background_min.end(), width);
+    std::fill(background_max.begin(), background_max.end(), -1);
+    std::vector<Pixel>::const_iterator it;
+    for(it = pixels.begin(); it != pixels.end(); it++) {
+        int i = (*it).getI();
+        int j = (*it).getJ();
+        if(i >= 0 && i < width && j >= 0 && j < height) {
+            background[i + (width * j)] = (*it).getChar();
+            background_min[j] = std::min(background_min[j], i);
+            background_max[j] = std::max(background_max[j], i);
+        }
+    }
+
+    // Clear the frame drawn so far and start it from the background
+    for(int j = 0; j < height; j++) {
+        if(dirty_min[j] <= dirty_max[j]) {
+            std::fill(frame.begin() + (j * width) + dirty_min[j], frame.begin() + (j * width) + dirty_max[j] + 1, EMPTY);
+        }
+        if(background_min[j] <= background_max[j]) {
+            std::memcpy(&frame[(j * width) + background_min[j]], &background[(j * width) + background_min[j]],
+                        background_max[j] - background_min[j] + 1);
+        }
+        dirty_min[j] = background_min[j];
+        dirty_max[j] = background_max[j];
     }
 }
 
 // Calculate the difference between the frame and the previous frame to decrease how much is needed to print to
 // the terminal since it is slow.  This also decrease the required bandwidth if being displayed over ssh.
-std::vector<Pixel> Screen::pullDeltaFrame() {
-    // Define return pixel vector
-    std::vector<Pixel> delta;
-    // For every pixel check to see if the char value is different between frame and previous frame
-    for(int j = 0; j < height; j++) {
-        for(int i = 0; i < width; i++) {
-            int index = i + (j * width);
-            if((*frame)[index].getChar() != (*previous_frame)[index].getChar()) {
-                // If they chars are different add the new pixel to the output pixel vector
-                delta.push_back((*frame)[index]);
+// Only the columns that either frame wrote to are compared, and the spans come out in row then column order.
+void Screen::pullDeltaFrame() {
+    Trace::Scope trace("pullDeltaFrame");
+    delta.clear();
+    // Top row first, so the cursor mostly moves down and can use newlines
+    for(int j = height - 1; j >= 0; j--) {
+        int lo = std::min(dirty_min[j], previous_dirty_min[j]);
+        int hi = std::max(dirty_max[j], previous_dirty_max[j]);
+        const char * row = &frame[j * width];
+        const char * previous_row = &previous_frame[j * width];
+        for(int i = lo; i <= hi; i++) {
+            if(row[i] != previous_row[i]) {
+                // Extend the last span if this char is right after it, otherwise start a new one
+                if(!delta.empty() && delta.back().j == j && delta.back().i + delta.back().length == i) {
+                    delta.back().length++;
+                } else {
+                    span s = { i, j, 1 };
+                    delta.push_back(s);
+                }
             }
         }
     }
-    // Sort the output vector to optimize how the pixels are printed to the screen
-    // Sort the output vector from smallest to largest i
-    std::sort(delta.begin(), delta.end(), Pixel::i_low_to_high());
-    // Sort the output vector from smallest to largest j
-    std::sort(delta.begin(), delta.end(), Pixel::j_low_to_high());
-    // Return the output vector
-    return delta;
 }
 
 // Add a vector of pixels to the current frame, overwriting previous char values for those pixels
-void Screen::addToFrame(std::vector <Pixel> add) {
-    std::vector<Pixel>::iterator it;
+void Screen::addToFrame(const std::vector <Pixel> &add) {
+    std::vector<Pixel>::const_iterator it;
     // Loop through each picture
     for(it = add.begin(); it != add.end(); it++) {
+        int i = (*it).getI();
+        int j = (*it).getJ();
         // Check to make sure the pixel is inside the screen
-        if((*it).getI() >= 0 && (*it).getI() < width && (*it).getJ() >= 0 && (*it).getJ() < height) {
-            // Update the current frames pixel value to the supplied value.
-            // This assumes that the frame pixel vector has order to it's pixels, e.g. rows together.
-            (*frame)[(*it).getI() + (width * (*it).getJ())].setChar((*it).getChar());
+        if(i >= 0 && i < width && j >= 0 && j < height) {
+            frame[i + (width * j)] = (*it).getChar();
+            // Grow the row's dirty columns to include this one
+            if(i < dirty_min[j]) {
+                dirty_min[j] = i;
+            }
+            if(i > dirty_max[j]) {
+                dirty_max[j] = i;
+            }
         }
     }
 }
 
 // This function displays the current frame
 void Screen::displayFrame() {
-    std::vector<Pixel> v_frame;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     // If the screen has not been drawn before draw the entirety of the previous frame
     if(first_frame) {
         first_frame = false;
-        v_frame = *previous_frame;
+        if(addressing == ABSOLUTE) {
+            // Clear the terminal and start at the top left so the screen's position is known
+            output.insert(output.end(), { '\033', '[', '2', 'J', '\033', '[', 'H' });
+        }
         for(int j = height; j >= -1; j--) {
             for(int i = -1; i <= width; i++) {
                 if(i >= 0 && i < width && j >= 0 && j < height) {
                     // Print the char value at the ixj coordinate
                     int index = i + (j * width);
-                    std::cout << v_frame[index].getChar();
+                    output.push_back(previous_frame[index]);
                 } else {
                     // Draw a frame around the screen
                     if(i == -1 || i == width) {
                         if(j == -1) {
                             if( i == -1) {
-                                std::cout << '\\';
+                                output.push_back('\\');
                             } else {
-                                std::cout << '/';
+                                output.push_back('/');
                             }
                         } else if(j == height) {
                             if( i == -1) {
-                                std::cout << '/';
+                                output.push_back('/');
                             } else {
-                                std::cout << '\\';
+                                output.push_back('\\');
                             }
                         } else {
-                            std::cout << '|';
+                            output.push_back('|');
                         }
                     } else {
-                        std::cout << '-';
+                        output.push_back('-');
                     }
                 }
             }
             if(j != -1) {
-                std::cout << std::endl;
-            } else {
-                // Set the cursor up for printed the delta frame
-                std::cout << std::flush;
-                moveCursorVertically(1);
-                moveCursorHorizontally(-width - 1);
+                output.push_back('\n');
             }
         }
+        // The cursor is just past the bottom right corner, set it up for printing the delta frame
+        cursor_i = width + 1;
+        cursor_j = -1;
+        moveCursorVertically(1);
+        moveCursorHorizontally(-width - 1);
     }
 
     // The cursor is assumed to be at the bottom left-hand corner.
     // The only reason this would not be true is if there was something externally typed.
-    int p_i = 0;
-    int p_j = 0;
+    cursor_i = 0;
+    cursor_j = 0;
     // Calculate the delta frame
-    v_frame = pullDeltaFrame();
-    // Loop through all the pixels in the delta frame
-    for(unsigned int i = 0; i < v_frame.size(); i++) {
-        Pixel p = v_frame[i];
-        // Find the difference in rows and columns to get to the current pixel value from where the cursor currently is.
-        int d_i = p.getI() - p_i;
-        int d_j = p.getJ() - p_j;
-        // Move the cursor to the current pixel location
-        moveCursorHorizontally(d_i);
-        moveCursorVertically(d_j);
-        // Print the char out at that location
-        std::cout << p.getChar() << std::flush;
-        // Update the current cursor position
-        p_i = p.getI() + 1;
-        p_j = p.getJ();
-        // While the next pixel is adjacent to this pixel
-        while ((i + 1) < v_frame.size() &&
-                v_frame[i + 1].getI() == p_i &&
-                v_frame[i + 1].getJ() == p_j) {
-            i++;
-            // Print out the char
-            std::cout << v_frame[i].getChar() << std::flush;
-            // Update the cursor position
-            p_i++;
-        }
+    pullDeltaFrame();
+    // Loop through all the spans in the delta frame
+    for(unsigned int k = 0; k < delta.size(); k++) {
+        const span &s = delta[k];
+        // Move the cursor to the start of the span and print out its chars
+        moveCursorTo(s.i, s.j);
+        const char * row = &frame[s.j * width];
+        output.insert(output.end(), row + s.i, row + s.i + s.length);
+        cursor_i += s.length;
     }
-    // Move the cursor back to the bottom left corner
-    moveCursorHorizontally( -p_i );
-    moveCursorVertically( -p_j );
-
-    // Create a new frame
-    newFrame();
 
     // Print any lines that the user has given the screen
     printLines();
     // Clear this frame's set of lines
     clearLines();
 
+    // Move the cursor back to the bottom left corner
+    moveCursorTo(0, 0);
+
+    // Create a new frame
+    newFrame();
+
+    // Send the whole frame to the terminal
+    std::chrono::steady_clock::time_point written = std::chrono::steady_clock::now();
+    flushOutput();
+    diff_time = std::chrono::duration<double>(written - start).count();
+    write_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - written).count();
+
 }
 
 // Print a value on the right side of the screen at a specified row for this frame.
@@ -222,22 +475,15 @@ void Screen::printLines() {
     std::vector<sideline>::iterator it;
     // Loop through each sideLine
     for(it = sideLines.begin(); it != sideLines.end(); it++) {
-        // Move the cursor to the specified position
-        moveCursorVertically(height - (*it).n);
-        moveCursorHorizontally(width + 1);
-        // Clear the line of the previous value
-        for(int i = 0; i < (*it).c_l; i++) {
-            std::cout << " " << std::flush;
+        // Move the cursor to the specified position, just right of the screen
+        moveCursorTo(width + 1, height - (*it).n);
+        // Print out the value, then blank out whatever is left of the previous value
+        putString((*it).s);
+        for(int i = (*it).s.length(); i < (*it).c_l; i++) {
+            put(' ');
         }
-        // Move the cursor back to the start of the line
-        moveCursorHorizontally( -(*it).c_l );
-        // Print out the value
-        std::cout << (*it).s << std::flush;
         // Update the clean_length value, so it is known how much needs to be erased
         (*it).c_l = (*it).s.length();
-        // Move the cursor back to the bottom left corner of the screen
-        moveCursorHorizontally( -width - 1 - (*it).s.length() );
-        moveCursorVertically(-height + (*it).n);
     }
 }
 
@@ -264,13 +510,62 @@ void Screen::line(double x1, double y1, double x2, double y2, char c, std::vecto
     bresenhamLine(x1, y1, x2, y2, c, vec);
 }
 
-// Line rasterization algorithm
-void Screen::bresenhamLine(double *p1, double *p2, char c, std::vector <Pixel> *vec) {
+// Helper function for bresenhamLine
+void Screen::line(const douglas::Vec2 &p1, const douglas::Vec2 &p2, char c, std::vector <Pixel> *vec) {
+    bresenhamLine(p1.x, p1.y, p2.x, p2.y, c, vec);
+}
+
+// Clip the line from (x1, y1) to (x2, y2) to the screen with the Liang-Barsky algorithm, moving the ends that are off
+// of the screen onto its edges.  Returns false when none of the line is on the screen.
+bool Screen::clipLine(double &x1, double &y1, double &x2, double &y2) {
+    const double dx = x2 - x1;
+    const double dy = y2 - y1;
+    // The line is x1 + t * dx, y1 + t * dy for t from 0 to 1, each edge of the screen cuts t down from one end
+    const double p[4] = { -dx, dx, -dy, dy };
+    const double q[4] = { x1, width - x1, y1, height - y1 };
+    double t0 = 0;
+    double t1 = 1;
+    for(int k = 0; k < 4; k++) {
+        if(p[k] == 0) {
+            // Parallel to this edge, so either all of it or none of it is inside
+            if(q[k] < 0) {
+                return false;
+            }
+        } else {
+            double t = q[k] / p[k];
+            if(p[k] < 0) {
+                if(t > t1) {
+                    return false;
+                }
+                t0 = std::max(t0, t);
+            } else {
+                if(t < t0) {
+                    return false;
+                }
+                t1 = std::min(t1, t);
+            }
+        }
+    }
+    // Lines that are already on the screen are left exactly as they are
+    if(t1 < 1) {
+        x2 = x1 + (t1 * dx);
+        y2 = y1 + (t1 * dy);
+    }
+    if(t0 > 0) {
+        x1 = x1 + (t0 * dx);
+        y1 = y1 + (t0 * dy);
+    }
+    return true;
+}
+
+// Line rasterization algorithm, the line is clipped to the screen first so only chars on the screen are visited
+// <plot> is called with the column and row of each char of the line
+template<typename Plot>
+void Screen::rasterize(double x1, double y1, double x2, double y2, Plot plot) {
 
-    double x1 = p1[0];
-    double y1 = p1[1];
-    double x2 = p2[0];
-    double y2 = p2[1];
+    if(!clipLine(x1, y1, x2, y2)) {
+        return;
+    }
 
     // Code modified from https://rosettacode.org/wiki/Bitmap/Bresenham%27s_line_algorithm#C.2B.2B
 
@@ -296,17 +591,21 @@ void Screen::bresenhamLine(double *p1, double *p2, char c, std::vector <Pixel> *
 
     const int maxX = (int)x2;
 
+    // A clipped end can land exactly on an edge and the last step can pass it, so those chars are still left out.
+    // As unsigned a negative column or row is past the edge as well.
     for(int x=(int)x1; x<maxX; x++)
     {
         if(steep)
         {
-            Pixel p(y, x, c);
-            vec->push_back(p);
+            if((unsigned int) y < (unsigned int) width && (unsigned int) x < (unsigned int) height) {
+                plot(y, x);
+            }
         }
         else
         {
-            Pixel p(x, y, c);
-            vec->push_back(p);
+            if((unsigned int) x < (unsigned int) width && (unsigned int) y < (unsigned int) height) {
+                plot(x, y);
+            }
         }
 
         error -= dy;
@@ -319,17 +618,27 @@ void Screen::bresenhamLine(double *p1, double *p2, char c, std::vector <Pixel> *
 
 }
 
-// Helper function for bresenhamLine
+// Line rasterization algorithm
+void Screen::bresenhamLine(double *p1, double *p2, char c, std::vector <Pixel> *vec) {
+    bresenhamLine(p1[0], p1[1], p2[0], p2[1], c, vec);
+}
+
+// Line rasterization algorithm, adding a Pixel for each char of the line that is on the screen to <vec>
 void Screen::bresenhamLine(double x1, double y1, double x2, double y2, char c, std::vector <Pixel> *vec) {
-    double * p1 = new double[2];
-    p1[0] = x1;
-    p1[1] = y1;
-    double * p2 = new double[2];
-    p2[0] = x2;
-    p2[1] = y2;
-    bresenhamLine(p1, p2, c, vec);
-    delete [] p1;
-    delete [] p2;
+    rasterize(x1, y1, x2, y2, [c, vec](int i, int j) { vec->push_back(Pixel(i, j, c)); });
+}
+
+// Draw a line straight into the current frame, for lines that are not kept between frames
+void Screen::drawLine(const douglas::Vec2 &p1, const douglas::Vec2 &p2, char c) {
+    rasterize(p1.x, p1.y, p2.x, p2.y, [this, c](int i, int j) {
+        frame[i + (width * j)] = c;
+        if(i < dirty_min[j]) {
+            dirty_min[j] = i;
+        }
+        if(i > dirty_max[j]) {
+            dirty_max[j] = i;
+        }
+    });
 }
 
 // Helper function for creating the outline of a triangle
@@ -11,6 +11,8 @@
 #include <vector>
 #include <string>
 #include "pixel.hpp"
+#include "output_sink.hpp"
+#include "../personal_utilities/vec2.hpp"
 
 // Screen abstracts the pixel and frame calculations as well as the printing to the screen.
 // It handles it correctly with and arbitrary integer width and height.
@@ -24,20 +26,79 @@ protected:
         int c_l;
     };
 
+    // A run of changed chars in one row, starting at column i
+    struct span {
+        int i;
+        int j;
+        int length;
+    };
+
     int width, height;
     bool first_frame = true;
 
-    std::vector<Pixel>* previous_frame;
-    std::vector<Pixel>* frame;
+    // Two flat width * height grids of chars, row j starts at j * width.  frame is the one being drawn and
+    // previous_frame is what is on the terminal, they trade places each time a frame is displayed.
+    std::vector<char> previous_frame;
+    std::vector<char> frame;
+
+    // Columns written in each row of each frame, dirty_min to dirty_max inclusive, empty when dirty_min > dirty_max.
+    // Every char of a frame outside of these is empty, so only these columns need to be compared or cleared.
+    std::vector<int> dirty_min;
+    std::vector<int> dirty_max;
+    std::vector<int> previous_dirty_min;
+    std::vector<int> previous_dirty_max;
+
+    std::vector<span> delta;
+
+    // Chars that every frame starts from in place of blanks, with the columns used in each row of it the same way as
+    // the dirty columns.  background_key names the pixels it was last built from so it is only built again when
+    // they change.
+    std::vector<char> background;
+    std::vector<int> background_min;
+    std::vector<int> background_max;
+    unsigned long background_key = 0;
 
     std::vector<sideline> sideLines;
 
+    // Everything written to the terminal in a frame is collected here and sent to the sink with a single write
+    std::vector<char> output;
+    OutputSink* sink;
+    bool owns_sink;
+    // Where the cursor is, in screen columns and rows from the bottom left char
+    int cursor_i = 0;
+    int cursor_j = 0;
+
+    // Seconds the last displayFrame spent working out the output and writing it to the sink
+    double diff_time = 0;
+    double write_time = 0;
+
     void newFrame();
-    std::vector<Pixel> pullFrame();
-    std::vector<Pixel> pullDeltaFrame();
+    void pullDeltaFrame();
+
+    void put(char c);
+    void putNumber(int n);
+    void putString(const std::string &s);
+    void flushOutput();
+
+    // Ways of moving along a row that moveCursorTo picks between
+    enum HorizontalMove {
+        H_NONE,
+        H_RELATIVE,             // CSI n C or CSI n D
+        H_COLUMN,               // CSI n G
+        H_OVERPRINT,            // Print the chars that are already there
+        H_RETURN_OVERPRINT,     // Carriage return, then print the chars that are already there
+        H_RETURN_RELATIVE       // Carriage return, then CSI n C
+    };
+
+    bool clipLine(double &x1, double &y1, double &x2, double &y2);
+    template<typename Plot> void rasterize(double x1, double y1, double x2, double y2, Plot plot);
+
+    char shownChar(int i, int j);
+    int planHorizontal(int from, int i, int j, HorizontalMove* move);
 
     void moveCursorVertically(int j);
     void moveCursorHorizontally(int i);
+    void moveCursorTo(int i, int j);
 
     // Fast absolute value for line algorithm
     double fabs(double d) {
@@ -59,13 +120,36 @@ protected:
 
 public:
 
-    Screen(int width, int height);
+    constexpr static char EMPTY = ' ';
+
+    // How the cursor is moved between the spans of a frame
+    enum Addressing {
+        RELATIVE,   // Only relative moves from where the screen was first drawn, anything printed above it is kept
+        ABSOLUTE    // The terminal is cleared on the first frame so absolute moves can be used whenever shorter
+    };
+
+protected:
+    Addressing addressing = RELATIVE;
+
+public:
+
+    Screen(int width, int height, OutputSink* sink = nullptr);
+    Screen(const Screen &obj) = delete;
+    Screen &operator =(const Screen &obj) = delete;
     ~Screen();
 
     int getWidth() { return width; }
     int getHeight() { return height; }
 
-    void addToFrame(std::vector<Pixel>);
+    Addressing getAddressing() { return addressing; }
+    void setAddressing(Addressing addressing) { this->addressing = addressing; }
+
+    OutputSink* getSink() { return sink; }
+    double getDiffTime() { return diff_time; }
+    double getWriteTime() { return write_time; }
+
+    void addToFrame(const std::vector<Pixel> &add);
+    void setBackground(const std::vector<Pixel> &pixels, unsigned long key);
     void displayFrame();
 
     void printValue(int j, std::string value);
@@ -75,9 +159,11 @@ public:
     void line(double * p1, double * p2, char c, std::vector<Pixel>* vec);
     void line(const double * p1, const double * p2, char c, std::vector<Pixel>* vec);
     void line(double x1, double y1, double x2, double y2, char c, std::vector<Pixel>* vec);
+    void line(const douglas::Vec2 &p1, const douglas::Vec2 &p2, char c, std::vector<Pixel>* vec);
     void bresenhamLine(double * p1, double * p2, char c, std::vector<Pixel>* vec);
     void bresenhamLine(double x1, double y1, double x2, double y2, char c, std::vector<Pixel>* vec);
     void outlineTriangle(double * p1, double * p2, double * p3, char c, std::vector<Pixel>* vec);
+    void drawLine(const douglas::Vec2 &p1, const douglas::Vec2 &p2, char c);
 
 };
 
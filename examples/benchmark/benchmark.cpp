@@ -0,0 +1,496 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This file is the entry point for the micro benchmarks.  Each kernel is run on a set of particle
+ *              counts until it has run for a minimum time, and the nanoseconds and heap allocations for each call
+ *              are printed so a slow down in a frame can be traced back to the kernel that caused it.
+ *
+ *              Usage: benchmark [--sizes n,n,...] [--filter name] [--min-time seconds]
+ *              The numbers only mean something next to each other.  The makefile builds the benchmark and its own
+ *              copy of the code under test with BENCH_CXXFLAGS (-O2), which are printed above the results.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../../display/screen.hpp"
+#include "../../display/output_sink.hpp"
+#include "../../game/player/wheel.hpp"
+#include "../../physics/constraints/box_constraint.hpp"
+#include "../../physics/constraints/line_constraint.hpp"
+#include "../../physics/objects/movable_wall.hpp"
+#include "../../physics/objects/wall.hpp"
+#include "../../physics/line_batch.hpp"
+#include "../../personal_utilities/vec2.hpp"
+#include "../../personal_utilities/vec_func.hpp"
+
+// Every heap allocation made by the program, counted so each kernel's allocations can be reported
+static std::atomic<unsigned long> allocations(0);
+
+void* operator new(std::size_t size) {
+    allocations++;
+    void* p = std::malloc(size > 0 ? size : 1);
+    if(p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+// Flags the benchmark was compiled with, passed in by the makefile
+#ifndef BENCH_CXXFLAGS
+#define BENCH_CXXFLAGS "unknown"
+#endif
+
+// Keeps results alive so the work that made them is not optimized away
+static volatile double sink_value = 0;
+
+// One kernel set up for a particle count.  reset() puts the state back to where it started and is not timed, run()
+// is the call being measured.
+class Case {
+public:
+    virtual ~Case() {}
+    virtual void reset() {}
+    virtual void run() = 0;
+};
+
+// Detached particles with a saved copy of their positions so they can be put back after every run
+class Particles {
+    std::vector<Particle*> owned;
+    std::vector<Particle*> all;
+    std::vector<douglas::Vec2> pos;
+    std::vector<douglas::Vec2> ppos;
+public:
+    ~Particles() {
+        for(unsigned int i = 0; i < owned.size(); i++) {
+            delete owned[i];
+        }
+    }
+
+    // Make a particle at <p> that moved from <pp> last step
+    Particle* add(const douglas::Vec2 &p, const douglas::Vec2 &pp) {
+        Particle* particle = new Particle(douglas::vector::vector(p.x, p.y));
+        particle->setPPosition(pp);
+        owned.push_back(particle);
+        track(particle);
+        return particle;
+    }
+
+    // Save and restore a particle owned by something else
+    void track(Particle* particle) {
+        all.push_back(particle);
+        pos.push_back(particle->getPosition());
+        ppos.push_back(particle->getPPosition());
+    }
+
+    void restore() {
+        for(unsigned int i = 0; i < all.size(); i++) {
+            all[i]->setPosition(pos[i]);
+            all[i]->setPPosition(ppos[i]);
+        }
+    }
+
+    const std::vector<Particle*>& getOwned() { return owned; }
+};
+
+// Random numbers with a fixed seed so every run measures the same work
+static std::mt19937 rng;
+
+double uniform(double low, double high) {
+    return std::uniform_real_distribution<double>(low, high)(rng);
+}
+
+// Pairs of particles that are all the wrong distance apart
+class LineConstraintCase : public Case {
+    Particles particles;
+    LineConstraint constraint;
+public:
+    LineConstraintCase(unsigned int n) : constraint(5.0, Constraint::EQUAL) {
+        for(unsigned int i = 0; i < n + (n % 2); i++) {
+            douglas::Vec2 p(uniform(0, 100), uniform(0, 50));
+            constraint.addParticle(particles.add(p, p));
+        }
+    }
+    void reset() { particles.restore(); }
+    void run() { constraint.PairConstraint::fix(0); }
+};
+
+// Groups of four particles held together by a line constraint between every two of them, the way a Box is, solved
+// either one constraint at a time in order or as a LineBatch with one of its kernels
+class LineBatchCase : public Case {
+    Particles particles;
+    std::vector<LineConstraint*> lines;
+    LineBatch batch;
+    bool batched;
+public:
+    LineBatchCase(unsigned int n, bool batched, LineBatch::Kernel kernel) : batched(batched) {
+        for(unsigned int g = 0; g < std::max(n / 4, 1u); g++) {
+            douglas::Vec2 center(uniform(0, 100), uniform(0, 50));
+            Particle* corners[4];
+            for(unsigned int i = 0; i < 4; i++) {
+                douglas::Vec2 p = center + douglas::Vec2(uniform(-2, 2), uniform(-2, 2));
+                corners[i] = particles.add(p, p);
+            }
+            for(unsigned int i = 0; i < 4; i++) {
+                for(unsigned int j = i + 1; j < 4; j++) {
+                    double length = corners[i]->getPosition().distance(corners[j]->getPosition()) * uniform(0.9, 1.1);
+                    LineConstraint* line = new LineConstraint(length, Constraint::EQUAL);
+                    line->addParticle(corners[i]);
+                    line->addParticle(corners[j]);
+                    lines.push_back(line);
+                }
+            }
+        }
+        batch.setKernel(kernel);
+        batch.build(lines, particles.getOwned().front()->getStore());
+    }
+    ~LineBatchCase() {
+        for(unsigned int i = 0; i < lines.size(); i++) {
+            delete lines[i];
+        }
+    }
+    void reset() { particles.restore(); }
+    void run() {
+        if(batched) {
+            batch.solve();
+        } else {
+            for(unsigned int i = 0; i < lines.size(); i++) {
+                lines[i]->PairConstraint::fix(0);
+            }
+        }
+    }
+};
+
+// Particles that all crossed a static wall last step
+class WallCase : public Case {
+    Particles particles;
+    Wall* wall;
+    SingleConstraint* constraint;
+public:
+    WallCase(unsigned int n) {
+        double top[2] = { 50, 45 };
+        double bottom[2] = { 50, 5 };
+        wall = new Wall(top, bottom);
+        constraint = wall->getSuperGlobalConstraints()[0];
+        for(unsigned int i = 0; i < n; i++) {
+            double y = uniform(10, 40);
+            particles.add(douglas::Vec2(uniform(50.1, 60), y), douglas::Vec2(uniform(40, 49.9), y));
+        }
+    }
+    ~WallCase() { delete wall; }
+    void reset() { particles.restore(); }
+    void run() {
+        const std::vector<Particle*> &p = particles.getOwned();
+        for(unsigned int i = 0; i < p.size(); i++) {
+            constraint->fix(0, p[i]);
+        }
+    }
+};
+
+// Particles that all crossed a wall that is pushed by them
+class MovableWallCase : public Case {
+    Particles particles;
+    MovableWall* wall;
+    SingleConstraint* constraint;
+public:
+    MovableWallCase(unsigned int n) {
+        double top[2] = { 50, 45 };
+        double bottom[2] = { 50, 5 };
+        wall = new MovableWall(top, bottom);
+        constraint = wall->getSuperGlobalConstraints()[0];
+        const std::vector<Particle*> &ends = wall->getImmediateParticles();
+        for(unsigned int i = 0; i < ends.size(); i++) {
+            particles.track(ends[i]);
+        }
+        for(unsigned int i = 0; i < n; i++) {
+            double y = uniform(10, 40);
+            particles.add(douglas::Vec2(uniform(50.1, 60), y), douglas::Vec2(uniform(40, 49.9), y));
+        }
+    }
+    ~MovableWallCase() { delete wall; }
+    void reset() { particles.restore(); }
+    void run() {
+        const std::vector<Particle*> &p = particles.getOwned();
+        for(unsigned int i = 0; i < p.size(); i++) {
+            constraint->fix(0, p[i]);
+        }
+    }
+};
+
+// A wheel's sideways drag applied to pairs of particles that are all sliding
+class WheelCase : public Case {
+    Particles particles;
+    Wheel* wheel;
+    Constraint* constraint = nullptr;
+public:
+    WheelCase(unsigned int n) {
+        double pos[2] = { 50, 25 };
+        wheel = new Wheel(pos, 5, 3, 0, 100000.0);
+        // The constraint is private to Wheel so it is found by its registered type
+        TypeId wheel_constraint = Typed::registerType("wheel_constraint");
+        std::vector<Constraint*> constraints = wheel->getSpecificConstraints();
+        for(unsigned int i = 0; i < constraints.size(); i++) {
+            if(constraints[i]->isType(wheel_constraint)) {
+                constraint = constraints[i];
+            }
+        }
+        const std::vector<Particle*> &own = wheel->getImmediateParticles();
+        for(unsigned int i = 0; i < own.size(); i++) {
+            particles.track(own[i]);
+        }
+        for(unsigned int i = 0; i < n + (n % 2); i += 2) {
+            douglas::Vec2 p(uniform(0, 100), uniform(0, 50));
+            douglas::Vec2 slide(uniform(-1, 1), uniform(-1, 1));
+            constraint->addParticle(particles.add(p, p - slide));
+            constraint->addParticle(particles.add(p + douglas::Vec2(0, 3), p + douglas::Vec2(0, 3) - slide));
+        }
+    }
+    ~WheelCase() { delete wheel; }
+    void reset() { particles.restore(); }
+    void run() { constraint->fix(0); }
+};
+
+// Particles that are half inside and half outside of a box
+class BoxCase : public Case {
+    Particles particles;
+    BoxConstraint constraint;
+public:
+    BoxCase(unsigned int n) : constraint(0, 0, 100, 50, 0.5) {
+        for(unsigned int i = 0; i < n; i++) {
+            douglas::Vec2 p(uniform(-20, 120), uniform(-10, 60));
+            particles.add(p, p);
+        }
+    }
+    void reset() { particles.restore(); }
+    void run() {
+        const std::vector<Particle*> &p = particles.getOwned();
+        for(unsigned int i = 0; i < p.size(); i++) {
+            constraint.fix(0, p[i]);
+        }
+    }
+};
+
+// Random pairs of segments, through either the double pointer or the Vec2 intersection, most of them miss
+class IntersectionCase : public Case {
+    std::vector<douglas::Vec2> points;
+    bool vec2;
+public:
+    IntersectionCase(unsigned int n, bool vec2) : vec2(vec2) {
+        for(unsigned int i = 0; i < n * 4; i++) {
+            points.push_back(douglas::Vec2(uniform(0, 100), uniform(0, 50)));
+        }
+    }
+    void run() {
+        double sum = 0;
+        for(unsigned int i = 0; i < points.size(); i += 4) {
+            if(vec2) {
+                douglas::Intersection hit = douglas::intersection(points[i], points[i + 1], points[i + 2], points[i + 3]);
+                if(hit) {
+                    sum += hit.point.x;
+                }
+            } else {
+                double a1[2] = { points[i].x, points[i].y };
+                double a2[2] = { points[i + 1].x, points[i + 1].y };
+                double b1[2] = { points[i + 2].x, points[i + 2].y };
+                double b2[2] = { points[i + 3].x, points[i + 3].y };
+                // Segments that miss are reported by an exception, which is part of what is being measured
+                try {
+                    double * hit = douglas::vector::intersection(a1, a2, b1, b2);
+                    sum += hit[0];
+                    delete [] hit;
+                } catch (std::out_of_range &e) {}
+            }
+        }
+        sink_value = sum;
+    }
+};
+
+// Screen that lets the benchmarks reach its frame diff
+class BenchScreen : public Screen {
+public:
+    BenchScreen(int width, int height, OutputSink* sink) : Screen(width, height, sink) {}
+    using Screen::newFrame;
+    using Screen::pullDeltaFrame;
+};
+
+// Random lines across a terminal sized screen, rasterized into a reused pixel list
+class BresenhamCase : public Case {
+    MemorySink sink;
+    BenchScreen screen;
+    std::vector<douglas::Vec2> points;
+    std::vector<Pixel> pixels;
+public:
+    BresenhamCase(unsigned int n) : sink(false), screen(150, 50, &sink) {
+        for(unsigned int i = 0; i < n * 2; i++) {
+            points.push_back(douglas::Vec2(uniform(0, 150), uniform(0, 50)));
+        }
+        pixels.reserve(n * 200);
+    }
+    void run() {
+        pixels.clear();
+        for(unsigned int i = 0; i < points.size(); i += 2) {
+            screen.bresenhamLine(points[i].x, points[i].y, points[i + 1].x, points[i + 1].y, '#', &pixels);
+        }
+    }
+};
+
+// Two frames of <n> random pixels each, diffed into spans
+class DeltaFrameCase : public Case {
+    MemorySink sink;
+    BenchScreen screen;
+    std::vector<Pixel> previous;
+    std::vector<Pixel> current;
+public:
+    DeltaFrameCase(unsigned int n) : sink(false), screen(150, 50, &sink) {
+        for(unsigned int i = 0; i < n; i++) {
+            previous.push_back(Pixel(rng() % 150, rng() % 50, '#'));
+            current.push_back(Pixel(rng() % 150, rng() % 50, '@'));
+        }
+    }
+    void reset() {
+        screen.newFrame();
+        screen.addToFrame(previous);
+        screen.newFrame();
+        screen.addToFrame(current);
+    }
+    void run() { screen.pullDeltaFrame(); }
+};
+
+// A named kernel and how to set it up for a particle count
+struct Kernel {
+    std::string name;
+    std::function<Case*(unsigned int)> make;
+};
+
+// Result of measuring one kernel at one size
+struct Result {
+    unsigned long runs;
+    double ns_per_op;
+    double allocations_per_op;
+};
+
+// Run <c> until it has been timed for at least <min_time> seconds, only the calls to run() are counted
+Result measure(Case* c, double min_time) {
+    // One untimed run so caches and lazily grown buffers are warm
+    c->reset();
+    c->run();
+
+    Result result = { 0, 0, 0 };
+    double elapsed = 0;
+    unsigned long allocated = 0;
+    while(elapsed < min_time || result.runs < 3) {
+        c->reset();
+        unsigned long a = allocations;
+        std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+        c->run();
+        elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+        allocated += allocations - a;
+        result.runs++;
+    }
+    result.ns_per_op = elapsed * 1e9 / result.runs;
+    result.allocations_per_op = (double) allocated / result.runs;
+    return result;
+}
+
+// Parse a comma separated list of sizes
+std::vector<unsigned int> parseSizes(const std::string &text) {
+    std::vector<unsigned int> sizes;
+    size_t start = 0;
+    while(start < text.length()) {
+        size_t end = text.find(',', start);
+        if(end == std::string::npos) {
+            end = text.length();
+        }
+        sizes.push_back(std::stoul(text.substr(start, end - start)));
+        start = end + 1;
+    }
+    return sizes;
+}
+
+int main (int argc, char** argv) {
+
+    std::vector<unsigned int> sizes = { 16, 256, 4096 };
+    std::string filter;
+    double min_time = 0.2;
+
+    try {
+        for(int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if(i + 1 >= argc) {
+                throw std::invalid_argument("Unknown or incomplete option " + arg);
+            } else if(arg == "--sizes") {
+                sizes = parseSizes(argv[++i]);
+            } else if(arg == "--filter") {
+                filter = argv[++i];
+            } else if(arg == "--min-time") {
+                min_time = std::stod(argv[++i]);
+            } else {
+                throw std::invalid_argument("Unknown option " + arg);
+            }
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<Kernel> kernels = {
+        { "line_constraint/fix", [](unsigned int n) -> Case* { return new LineConstraintCase(n); } },
+        { "line_batch/tree_order", [](unsigned int n) -> Case* {
+            return new LineBatchCase(n, false, LineBatch::AUTO); } },
+        { "line_batch/auto", [](unsigned int n) -> Case* { return new LineBatchCase(n, true, LineBatch::AUTO); } },
+        { "line_batch/scalar", [](unsigned int n) -> Case* { return new LineBatchCase(n, true, LineBatch::SCALAR); } },
+        { "line_batch/sse2", [](unsigned int n) -> Case* { return new LineBatchCase(n, true, LineBatch::SSE2); } },
+        { "line_batch/avx2", [](unsigned int n) -> Case* { return new LineBatchCase(n, true, LineBatch::AVX2); } },
+        { "wall_constraint/fix", [](unsigned int n) -> Case* { return new WallCase(n); } },
+        { "movable_wall_constraint/fix", [](unsigned int n) -> Case* { return new MovableWallCase(n); } },
+        { "wheel_constraint/fix", [](unsigned int n) -> Case* { return new WheelCase(n); } },
+        { "box_constraint/fix", [](unsigned int n) -> Case* { return new BoxCase(n); } },
+        { "intersection/vec_func", [](unsigned int n) -> Case* { return new IntersectionCase(n, false); } },
+        { "intersection/vec2", [](unsigned int n) -> Case* { return new IntersectionCase(n, true); } },
+        { "screen/bresenhamLine", [](unsigned int n) -> Case* { return new BresenhamCase(n); } },
+        { "screen/pullDeltaFrame", [](unsigned int n) -> Case* { return new DeltaFrameCase(n); } }
+    };
+
+#ifdef __OPTIMIZE__
+    std::printf("built with: %s\n", BENCH_CXXFLAGS);
+#else
+    std::printf("built with: %s (NOT optimized, these are not performance numbers)\n", BENCH_CXXFLAGS);
+#endif
+    std::printf("%-32s %8s %14s %12s %12s\n", "kernel", "n", "ns/op", "ns/item", "allocs/op");
+    for(unsigned int k = 0; k < kernels.size(); k++) {
+        if(kernels[k].name.find(filter) == std::string::npos) {
+            continue;
+        }
+        for(unsigned int s = 0; s < sizes.size(); s++) {
+            rng.seed(sizes[s]);
+            Case* c = kernels[k].make(sizes[s]);
+            Result r = measure(c, min_time);
+            delete c;
+            std::printf("%-32s %8u %14.1f %12.2f %12.2f\n", kernels[k].name.c_str(), sizes[s],
+                        r.ns_per_op, r.ns_per_op / std::max(sizes[s], 1u), r.allocations_per_op);
+        }
+    }
+
+    return 0;
+
+}
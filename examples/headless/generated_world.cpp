@@ -0,0 +1,40 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the source file for the GeneratedWorld class
+ */
+
+#include "generated_world.hpp"
+
+TypeId GeneratedWorld::TYPE = Typed::registerType("generated_world");
+
+// Constructor
+// <u_w> and <u_h> are the size of the world in units
+// <generator> makes the scene, it is copied so the world can be generated again
+GeneratedWorld::GeneratedWorld(double u_w, double u_h, const SceneGenerator &generator) : Space(u_w, u_h),
+                                                                                        generator(generator) {
+    addType(GeneratedWorld::TYPE);
+    setup();
+}
+
+// Fill the world with the generated scene
+void GeneratedWorld::setup() {
+    boundary->setRigid(0.01);
+    generator.populate(this);
+}
+
+// Step everything and then relax the constraints
+void GeneratedWorld::step(double dt) {
+
+    GameObject::step(dt);
+
+    handlePhysics(GeneratedWorld::RELAXATION_ROUNDS);
+
+}
+
+// Render everything in the world
+void GeneratedWorld::render(Screen* screen) {
+
+    renderChildren(screen);
+
+}
@@ -0,0 +1,30 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the header file for the GeneratedWorld class
+ */
+
+#ifndef FINAL_PROJECT_GENERATED_WORLD_HPP
+#define FINAL_PROJECT_GENERATED_WORLD_HPP
+
+#include "../../space.hpp"
+#include "scene_generator.hpp"
+
+// GeneratedWorld is a Space with nothing in it but what a SceneGenerator puts there, stepped like the EmptyWorld
+class GeneratedWorld : public Space {
+protected:
+    SceneGenerator generator;
+public:
+
+    static TypeId TYPE;
+    constexpr static int RELAXATION_ROUNDS = 5;
+
+    GeneratedWorld(double u_w, double u_h, const SceneGenerator &generator);
+
+    void setup();
+    void render(Screen*);
+    void step(double);
+
+};
+
+#endif //FINAL_PROJECT_GENERATED_WORLD_HPP
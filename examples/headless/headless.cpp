@@ -0,0 +1,482 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This file is the entry point for the headless runner.  It plays the game, the physics test's
+ *              EmptyWorld or a generated scene, for a fixed number of steps at a fixed dt with scripted keys and no
+ *              terminal, then prints how long each phase of a frame took as JSON so throughput can be compared
+ *              between builds.
+ *
+ *              Usage: headless [--world grid|empty|scene] [--steps n] [--dt seconds] [--threads n]
+ *                              [--script keys:steps,...] [--no-render] [--terminal] [--record file] [--json file]
+ *                              [--trace file] [--line-kernel off|auto|scalar|sse2|avx2] [--no-broadphase]
+ *                              [--seed n] [--particles n] [--boxes n] [--walls n] [--movable-walls n]
+ *                              [--sweep scale,scale,...]
+ *
+ *              The scene world is made by a SceneGenerator from the seed and counts, and --sweep runs it once for
+ *              each scale of those counts so the cost of a growing world can be seen.  --line-kernel solves the
+ *              EQUAL line constraints of every Space as a LineBatch with the given kernel, off keeps them in tree order.
+ *              --no-broadphase tests every particle against every global constraint, a run with it has to end with
+ *              the same checksum as one without, which is what the makefile's check target compares.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../display/screen.hpp"
+#include "../../display/output_sink.hpp"
+#include "../../display/frame_stats.hpp"
+#include "../../game/grid.hpp"
+#include "../../personal_utilities/thread_pool.hpp"
+#include "../../personal_utilities/vec_func.hpp"
+#include "../../trace.hpp"
+#include "../physics_test/empty_world.hpp"
+#include "generated_world.hpp"
+#include "scene_generator.hpp"
+
+// Counts the bytes of every frame and passes them on to another sink if there is one
+class CountingSink : public OutputSink {
+    OutputSink* forward;
+    size_t bytes = 0;
+public:
+    CountingSink(OutputSink* forward) : forward(forward) {}
+
+    void begin(int width, int height) {
+        if(forward != nullptr) {
+            forward->begin(width, height);
+        }
+    }
+    void write(const char * data, size_t length) {
+        bytes += length;
+        if(forward != nullptr) {
+            forward->write(data, length);
+        }
+    }
+    size_t getBytes() { return bytes; }
+};
+
+// Seconds spent in one phase of every frame, every sample is also kept in <stats> for its percentiles
+struct Phase {
+    std::string name;
+    double total = 0;
+    double min = std::numeric_limits<double>::max();
+    double max = 0;
+    unsigned int count = 0;
+    FrameStats* stats;
+    unsigned int series;
+
+    Phase(const std::string &name, FrameStats* stats) : name(name), stats(stats), series(stats->getSeries(name)) {}
+
+    void add(double seconds) {
+        total += seconds;
+        min = std::min(min, seconds);
+        max = std::max(max, seconds);
+        count++;
+        stats->add(series, seconds);
+    }
+};
+
+// Keys held down for a number of steps
+struct ScriptStep {
+    std::string keys;
+    unsigned int steps;
+};
+
+// Parse a script of comma separated keys:steps pairs, such as "w:40,wd:20,.:10".  The keys are any of w, a, s and d
+// held together, or '.' for none.
+std::vector<ScriptStep> parseScript(const std::string &script) {
+    std::vector<ScriptStep> steps;
+    size_t start = 0;
+    while(start < script.length()) {
+        size_t end = script.find(',', start);
+        if(end == std::string::npos) {
+            end = script.length();
+        }
+        std::string item = script.substr(start, end - start);
+        size_t colon = item.find(':');
+        if(colon == std::string::npos || colon == 0 || colon + 1 == item.length()) {
+            throw std::invalid_argument("Bad script step \"" + item + "\", expected keys:steps");
+        }
+        ScriptStep s;
+        s.keys = item.substr(0, colon);
+        s.steps = std::stoul(item.substr(colon + 1));
+        if(s.keys.find_first_not_of("wasd.") != std::string::npos) {
+            throw std::invalid_argument("Bad script keys \"" + s.keys + "\", only w, a, s, d and . are allowed");
+        }
+        steps.push_back(s);
+        start = end + 1;
+    }
+    if(steps.empty()) {
+        throw std::invalid_argument("The script is empty");
+    }
+    return steps;
+}
+
+// The keys held down at step <n>, the script repeats once it runs out
+const std::string& keysAt(const std::vector<ScriptStep> &script, unsigned int n) {
+    unsigned int length = 0;
+    for(unsigned int i = 0; i < script.size(); i++) {
+        length += script[i].steps;
+    }
+    if(length > 0) {
+        n %= length;
+    }
+    for(unsigned int i = 0; i < script.size(); i++) {
+        if(n < script[i].steps) {
+            return script[i].keys;
+        }
+        n -= script[i].steps;
+    }
+    return script.back().keys;
+}
+
+// Press <keys> the same way the game's input callbacks do
+void pressKeys(Player* player, const std::string &keys, double dt) {
+    double accel = 20;
+    double angle = douglas::pi / 9.0;
+    for(unsigned int i = 0; i < keys.length(); i++) {
+        switch (keys[i]) {
+            case 'w':
+                player->accelerate(accel, dt);
+                break;
+            case 's':
+                player->accelerate(-1 * accel, dt);
+                break;
+            case 'd':
+                player->steer(angle);
+                break;
+            case 'a':
+                player->steer(-1 * angle);
+                break;
+        }
+    }
+}
+
+// Sum of every particle's position weighted by its order, so two runs that end in the same place match
+double checksum(Space* space) {
+    double sum = 0;
+    const std::vector<Particle*> &particles = space->getParticles();
+    for(unsigned int i = 0; i < particles.size(); i++) {
+        douglas::Vec2 p = particles[i]->getPosition();
+        sum += (i + 1) * (p.x + 2 * p.y);
+    }
+    return sum;
+}
+
+// Write a phase as a JSON object
+void printPhase(std::ostream &out, const Phase &phase, bool last) {
+    FrameStats::Summary summary = phase.stats->summarize(phase.series);
+    out << "    \"" << phase.name << "\": { "
+        << "\"total\": " << phase.total << ", "
+        << "\"mean\": " << (phase.count > 0 ? phase.total / phase.count : 0) << ", "
+        << "\"min\": " << (phase.count > 0 ? phase.min : 0) << ", "
+        << "\"p50\": " << summary.p50 << ", "
+        << "\"p95\": " << summary.p95 << ", "
+        << "\"p99\": " << summary.p99 << ", "
+        << "\"max\": " << phase.max << " }" << (last ? "" : ",") << std::endl;
+}
+
+// Everything that decides what a run does
+struct Options {
+    std::string world = "grid";
+    unsigned int steps = 600;
+    double dt = 1.0 / 60.0;
+    unsigned int threads = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1;
+    std::string script_text = "w:40,wd:20,w:40,sa:20,.:10";
+    std::vector<ScriptStep> script;
+    bool render = true;
+    bool terminal = false;
+    std::string record_path;
+    std::string json_path;
+    std::string trace_path;
+    std::string line_kernel = "off";
+    bool broadphase = true;
+    SceneGenerator scene = SceneGenerator(1);
+    std::vector<double> sweep;
+};
+
+// Kernel named by <name>, throws if it is not one of auto, scalar, sse2 or avx2
+LineBatch::Kernel parseKernel(const std::string &name) {
+    const LineBatch::Kernel kernels[] = { LineBatch::AUTO, LineBatch::SCALAR, LineBatch::SSE2, LineBatch::AVX2 };
+    for(unsigned int i = 0; i < 4; i++) {
+        if(name == LineBatch::kernelName(kernels[i])) {
+            return kernels[i];
+        }
+    }
+    throw std::invalid_argument("The line kernel must be off, auto, scalar, sse2 or avx2");
+}
+
+// Run the world once and write its results to <out> as a JSON object
+void run(const Options &options, SceneGenerator scene, std::ostream &out) {
+
+    // Frames go to the terminal only when asked, the recording sits in front of everything else
+    TerminalSink terminal_sink;
+    CountingSink counter(options.terminal ? &terminal_sink : nullptr);
+    RecorderSink* recorder = nullptr;
+    if(!options.record_path.empty()) {
+        recorder = new RecorderSink(options.record_path, &counter);
+    }
+    Screen* screen = new Screen(150, 50, recorder != nullptr ? (OutputSink*) recorder : &counter);
+
+    // Threads besides this one, with none every task is run by this thread while it waits
+    ThreadPool* pool = new ThreadPool(options.threads);
+
+    Room* **grid = nullptr;
+    Space* world = nullptr;
+    Player* player = nullptr;
+    if(options.world == "grid") {
+        grid = createGrid(100.0, 50.0);
+        player = createPlayer(grid);
+    } else {
+        if(options.world == "empty") {
+            world = new EmptyWorld(100.0, 50.0);
+        } else {
+            world = new GeneratedWorld(100.0, 50.0, scene);
+        }
+        world->setSolverPool(pool);
+        std::vector<GameObject*> gos;
+        world->getChildrenOfType(Player::TYPE, &gos);
+        if(!gos.empty()) {
+            player = (Player*) gos.front();
+        }
+    }
+
+    // Line constraints and the broadphase are set up the same way in every Space that is stepped
+    std::vector<Space*> spaces;
+    if(grid != nullptr) {
+        for(unsigned int i = 0; i < 9; i++) {
+            spaces.push_back(grid[i % 3][i / 3]);
+        }
+    } else {
+        spaces.push_back(world);
+    }
+    for(unsigned int i = 0; i < spaces.size(); i++) {
+        if(options.line_kernel != "off") {
+            spaces[i]->setBatchedLines(true);
+            spaces[i]->getLineBatch()->setKernel(parseKernel(options.line_kernel));
+        }
+        spaces[i]->setUseBroadphase(options.broadphase);
+    }
+
+    // Every step is kept so the percentiles cover the whole run
+    FrameStats stats(options.steps);
+    Phase step("step", &stats);
+    Phase render_phase("render", &stats);
+    Phase diff("diff", &stats);
+    Phase write("write", &stats);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(unsigned int n = 0; n < options.steps; n++) {
+
+        if(player != nullptr) {
+            pressKeys(player, keysAt(options.script, n), options.dt);
+        }
+
+        Room* room = nullptr;
+        if(grid != nullptr) {
+            room = getPlayerRoom(grid);
+            updateMarkers(grid);
+        }
+
+        std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+        if(grid != nullptr) {
+            stepRooms(grid, options.dt, pool);
+        } else {
+            world->step(options.dt);
+        }
+        step.add(std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count());
+
+        if(options.render) {
+            t = std::chrono::steady_clock::now();
+            Space* rendered = room != nullptr ? (Space*) room : world;
+            {
+                Trace::Scope trace("render", rendered->getType());
+                rendered->render(screen);
+            }
+            render_phase.add(std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count());
+
+            screen->displayFrame();
+            diff.add(screen->getDiffTime());
+            write.add(screen->getWriteTime());
+        }
+
+        if(room != nullptr) {
+            room->checkPlayerLocation();
+        }
+    }
+    double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double sum = 0;
+    unsigned int particles = 0;
+    if(grid != nullptr) {
+        for(int i = 0; i < 3; i++) {
+            for(int j = 0; j < 3; j++) {
+                sum += checksum(grid[i][j]);
+                particles += grid[i][j]->getParticles().size();
+            }
+        }
+    } else {
+        sum = checksum(world);
+        particles = world->getParticles().size();
+    }
+
+    out << std::setprecision(9);
+    out << "{" << std::endl;
+    out << "  \"world\": \"" << options.world << "\"," << std::endl;
+    if(options.world == "scene") {
+        out << "  \"scene\": { \"seed\": " << scene.getSeed()
+            << ", \"particles\": " << scene.getParticles()
+            << ", \"boxes\": " << scene.getBoxes()
+            << ", \"walls\": " << scene.getWalls()
+            << ", \"movable_walls\": " << scene.getMovableWalls() << " }," << std::endl;
+    }
+    out << "  \"particles\": " << particles << "," << std::endl;
+    out << "  \"steps\": " << options.steps << "," << std::endl;
+    out << "  \"dt\": " << options.dt << "," << std::endl;
+    out << "  \"threads\": " << options.threads << "," << std::endl;
+    out << "  \"line_kernel\": \"" << options.line_kernel << "\"," << std::endl;
+    out << "  \"broadphase\": " << (options.broadphase ? "true" : "false") << "," << std::endl;
+    out << "  \"script\": \"" << options.script_text << "\"," << std::endl;
+    out << "  \"rendered\": " << (options.render ? "true" : "false") << "," << std::endl;
+    out << "  \"wall_time\": " << wall_time << "," << std::endl;
+    out << "  \"steps_per_second\": " << (wall_time > 0 ? options.steps / wall_time : 0) << "," << std::endl;
+    out << "  \"bytes_written\": " << counter.getBytes() << "," << std::endl;
+    out << "  \"checksum\": " << std::setprecision(15) << sum << std::setprecision(9) << "," << std::endl;
+    out << "  \"phases\": {" << std::endl;
+    printPhase(out, step, false);
+    printPhase(out, render_phase, false);
+    printPhase(out, diff, false);
+    printPhase(out, write, true);
+    out << "  }" << std::endl;
+    out << "}";
+
+    if(grid != nullptr) {
+        deleteGrid(grid);
+    }
+    delete world;
+    delete pool;
+    delete screen;
+    delete recorder;
+}
+
+// Parse a comma separated list of numbers
+std::vector<double> parseList(const std::string &text) {
+    std::vector<double> list;
+    size_t start = 0;
+    while(start < text.length()) {
+        size_t end = text.find(',', start);
+        if(end == std::string::npos) {
+            end = text.length();
+        }
+        list.push_back(std::stod(text.substr(start, end - start)));
+        start = end + 1;
+    }
+    return list;
+}
+
+int main (int argc, char** argv) {
+
+    Options options;
+    options.scene.setParticles(1000);
+    options.scene.setBoxes(20);
+    options.scene.setWalls(20);
+    options.scene.setMovableWalls(10);
+
+    try {
+        for(int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if(arg == "--no-render") {
+                options.render = false;
+            } else if(arg == "--no-broadphase") {
+                options.broadphase = false;
+            } else if(arg == "--terminal") {
+                options.terminal = true;
+            } else if(i + 1 >= argc) {
+                throw std::invalid_argument("Unknown or incomplete option " + arg);
+            } else if(arg == "--world") {
+                options.world = argv[++i];
+            } else if(arg == "--steps") {
+                options.steps = std::stoul(argv[++i]);
+            } else if(arg == "--dt") {
+                options.dt = std::stod(argv[++i]);
+            } else if(arg == "--threads") {
+                options.threads = std::stoul(argv[++i]);
+            } else if(arg == "--script") {
+                options.script_text = argv[++i];
+            } else if(arg == "--record") {
+                options.record_path = argv[++i];
+            } else if(arg == "--json") {
+                options.json_path = argv[++i];
+            } else if(arg == "--trace") {
+                options.trace_path = argv[++i];
+            } else if(arg == "--line-kernel") {
+                options.line_kernel = argv[++i];
+                if(options.line_kernel != "off") {
+                    parseKernel(options.line_kernel);
+                }
+            } else if(arg == "--seed") {
+                options.scene.setSeed(std::stoul(argv[++i]));
+            } else if(arg == "--particles") {
+                options.scene.setParticles(std::stoul(argv[++i]));
+            } else if(arg == "--boxes") {
+                options.scene.setBoxes(std::stoul(argv[++i]));
+            } else if(arg == "--walls") {
+                options.scene.setWalls(std::stoul(argv[++i]));
+            } else if(arg == "--movable-walls") {
+                options.scene.setMovableWalls(std::stoul(argv[++i]));
+            } else if(arg == "--sweep") {
+                options.sweep = parseList(argv[++i]);
+            } else {
+                throw std::invalid_argument("Unknown option " + arg);
+            }
+        }
+        if(options.world != "grid" && options.world != "empty" && options.world != "scene") {
+            throw std::invalid_argument("The world must be grid, empty or scene");
+        }
+        if(!options.sweep.empty() && options.world != "scene") {
+            throw std::invalid_argument("Only a generated scene can be swept");
+        }
+        options.script = parseScript(options.script_text);
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream json_file;
+    if(!options.json_path.empty()) {
+        json_file.open(options.json_path.c_str());
+    }
+    std::ostream &out = options.json_path.empty() ? std::cout : json_file;
+
+    Trace::setEnabled(!options.trace_path.empty());
+
+    if(options.sweep.empty()) {
+        run(options, options.scene, out);
+        out << std::endl;
+    } else {
+        // One run for each scale of the scene, as a JSON array
+        out << "[" << std::endl;
+        for(unsigned int i = 0; i < options.sweep.size(); i++) {
+            SceneGenerator scene = options.scene;
+            scene.scale(options.sweep[i]);
+            run(options, scene, out);
+            out << (i + 1 < options.sweep.size() ? "," : "") << std::endl;
+        }
+        out << "]" << std::endl;
+    }
+
+    if(!options.trace_path.empty()) {
+        Trace::setEnabled(false);
+        Trace::dump(options.trace_path);
+    }
+
+    return 0;
+
+}
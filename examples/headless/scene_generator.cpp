@@ -0,0 +1,75 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the source file for the SceneGenerator class
+ */
+
+#include "scene_generator.hpp"
+#include "../../physics/objects/box.hpp"
+#include "../../physics/objects/movable_wall.hpp"
+#include "../../physics/objects/wall.hpp"
+#include "../../personal_utilities/vec_func.hpp"
+#include <cmath>
+
+// Constructor
+// <seed> is the seed for every random choice the generator makes
+SceneGenerator::SceneGenerator(unsigned int seed) : seed(seed) {}
+
+// Random number between <low> and <high>
+double SceneGenerator::uniform(double low, double high) {
+    return std::uniform_real_distribution<double>(low, high)(rng);
+}
+
+// Multiply every count by <factor>, rounding to the nearest whole object
+void SceneGenerator::scale(double factor) {
+    particles = (unsigned int) std::round(particles * factor);
+    boxes = (unsigned int) std::round(boxes * factor);
+    walls = (unsigned int) std::round(walls * factor);
+    movable_walls = (unsigned int) std::round(movable_walls * factor);
+}
+
+// Add the scene to <space>'s physics.  Walls are placed first so nothing is generated on top of them in the same
+// frame they appear, then boxes and particles are given a small random velocity.
+void SceneGenerator::populate(Space* space) {
+    rng.seed(seed);
+    double w = space->getWidth();
+    double h = space->getHeight();
+    // Keep everything a little inside of the boundary
+    double margin = 2.0;
+
+    for(unsigned int i = 0; i < walls; i++) {
+        double angle = uniform(0, 2 * douglas::pi);
+        double length = uniform(5, 15);
+        douglas::Vec2 mid(uniform(margin, w - margin), uniform(margin, h - margin));
+        douglas::Vec2 d(std::cos(angle) * length / 2, std::sin(angle) * length / 2);
+        double top[2] = { mid.x + d.x, mid.y + d.y };
+        double bottom[2] = { mid.x - d.x, mid.y - d.y };
+        space->getPhysics()->addChild(new Wall(top, bottom));
+    }
+
+    for(unsigned int i = 0; i < movable_walls; i++) {
+        double angle = uniform(0, 2 * douglas::pi);
+        double length = uniform(4, 10);
+        douglas::Vec2 mid(uniform(margin, w - margin), uniform(margin, h - margin));
+        douglas::Vec2 d(std::cos(angle) * length / 2, std::sin(angle) * length / 2);
+        double top[2] = { mid.x + d.x, mid.y + d.y };
+        double bottom[2] = { mid.x - d.x, mid.y - d.y };
+        space->getPhysics()->addChild(new MovableWall(top, bottom));
+    }
+
+    for(unsigned int i = 0; i < boxes; i++) {
+        double b_w = uniform(2, 5);
+        double b_h = uniform(2, 5);
+        double corner[2] = { uniform(margin, w - margin - b_w), uniform(margin, h - margin - b_h) };
+        Box* box = new Box(corner, b_w, b_h);
+        box->addVelocity(douglas::Vec2(uniform(-0.2, 0.2), uniform(-0.2, 0.2)));
+        space->getPhysics()->addChild(box);
+    }
+
+    for(unsigned int i = 0; i < particles; i++) {
+        double vel[2] = { uniform(-0.3, 0.3), uniform(-0.3, 0.3) };
+        Particle* p = new Particle(douglas::vector::vector(uniform(margin, w - margin), uniform(margin, h - margin)),
+                                   vel);
+        space->getPhysics()->addChild(p);
+    }
+}
@@ -0,0 +1,45 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the header file for the SceneGenerator class
+ */
+
+#ifndef FINAL_PROJECT_SCENE_GENERATOR_HPP
+#define FINAL_PROJECT_SCENE_GENERATOR_HPP
+
+#include "../../space.hpp"
+#include <random>
+
+// SceneGenerator fills a Space with a given number of loose particles, boxes, walls and movable walls placed at
+// random.  The same seed and counts always make the same scene, so runs of different sizes can be compared.
+class SceneGenerator {
+protected:
+    unsigned int seed;
+    unsigned int particles = 0;
+    unsigned int boxes = 0;
+    unsigned int walls = 0;
+    unsigned int movable_walls = 0;
+
+    std::mt19937 rng;
+    double uniform(double low, double high);
+
+public:
+
+    SceneGenerator(unsigned int seed);
+
+    unsigned int getSeed() { return seed; }
+    void setSeed(unsigned int seed) { this->seed = seed; }
+    unsigned int getParticles() { return particles; }
+    void setParticles(unsigned int n) { this->particles = n; }
+    unsigned int getBoxes() { return boxes; }
+    void setBoxes(unsigned int n) { this->boxes = n; }
+    unsigned int getWalls() { return walls; }
+    void setWalls(unsigned int n) { this->walls = n; }
+    unsigned int getMovableWalls() { return movable_walls; }
+    void setMovableWalls(unsigned int n) { this->movable_walls = n; }
+
+    void scale(double factor);
+    void populate(Space* space);
+};
+
+#endif //FINAL_PROJECT_SCENE_GENERATOR_HPP
@@ -8,13 +8,14 @@
 #include "../../physics/objects/box.hpp"
 #include "../../game/player/player.hpp"
 #include "../../physics/objects/wall.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 #include <iostream>
 #include <vector>
 #include <algorithm>
 #include <string>
 #include <cmath>
 
-std::string EmptyWorld::TYPE = "empty_world";
+TypeId EmptyWorld::TYPE = Typed::registerType("empty_world");
 
 EmptyWorld::EmptyWorld(double u_w, double u_h) : Space(u_w, u_h) {
     addType(EmptyWorld::TYPE);
@@ -85,11 +86,9 @@ void EmptyWorld::setup() {
     player_pos[0] = 20.0;
     player_pos[1] = 20.0;
     Player* player = new Player(player_pos, 5.0, 10.0, 3.0, 100000.0, 100000.0);
-    double * player_vel = douglas::vector::vector(1, 5);
-    player->addVelocity(player_vel);
+    player->addVelocity(douglas::Vec2(1, 5));
     physics->addChild(player);
     delete [] player_pos;
-    delete [] player_vel;
 
     double * w_top = douglas::vector::vector(5.0 + unit_width / 2.0, (unit_height / 4.0) + (unit_height / 2.0));
     double * w_bot = douglas::vector::vector(unit_width / 2.0 - 5.0, (unit_height / 4.0));
@@ -11,7 +11,7 @@
 class EmptyWorld : public Space {
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
     constexpr static int RELAXATION_ROUNDS = 5;
 
     EmptyWorld(double u_w, double u_h);
@@ -17,6 +17,7 @@
 #include "../../game/player/player.hpp"
 #include "../../input.hpp"
 #include "../../personal_utilities/vec_func.hpp"
+#include "../../personal_utilities/thread_pool.hpp"
 
 int main (int argc, char** argv) {
 
@@ -27,6 +28,10 @@ int main (int argc, char** argv) {
     Screen* screen = new Screen(190, 60);
     EmptyWorld* emptyWorld = new EmptyWorld(100.0,50.0);
 
+    // The sandbox can hold many separate bodies, so their constraint islands are solved across a pool of threads
+    ThreadPool* pool = new ThreadPool();
+    emptyWorld->setSolverPool(pool);
+
     Input* input = new Input();
     input->listenTo('q', [&stop, &input](double dt) -> void {
         stop = true;
@@ -35,65 +40,24 @@ int main (int argc, char** argv) {
     double accel = 10;
     double angle = douglas::pi / 7.0;
     input->listenTo('w', [&emptyWorld, &accel](double dt) -> void {
-        double vel = accel;
-        if (dt < 0.1) {
-            vel *= dt * dt;
-        } else {
-            vel *= 0.01;
-        }
         std::vector<GameObject*> gos;
         emptyWorld->getChildrenOfType(Player::TYPE, &gos);
-        Player* player = (Player*) (*gos.begin());
-        gos.clear();
-        player->getChildrenOfType(Wheel::TYPE, &gos);
-        std::vector<GameObject*>::iterator it = gos.end();
-        it--;
-        Wheel* b_w = (Wheel*) (*it);
-        double * b_vel = b_w->getWheelVector();
-        douglas::vector::unitVector(b_vel);
-        douglas::vector::scale(b_vel, vel);
-        b_w->addVelocity(b_vel);
-        delete [] b_vel;
-
+        ((Player*) (*gos.begin()))->accelerate(accel, dt);
     });
     input->listenTo('s', [&emptyWorld, &accel](double dt) -> void {
-        double vel = -1 * accel;
-        if (dt < 0.1) {
-            vel *= dt * dt;
-        } else {
-            vel *= 0.01;
-        }
         std::vector<GameObject*> gos;
         emptyWorld->getChildrenOfType(Player::TYPE, &gos);
-        Player* player = (Player*) (*gos.begin());
-        gos.clear();
-        player->getChildrenOfType(Wheel::TYPE, &gos);
-        std::vector<GameObject*>::iterator it = gos.end();
-        it--;
-        Wheel* b_w = (Wheel*) (*it);
-        double * b_vel = b_w->getWheelVector();
-        douglas::vector::unitVector(b_vel);
-        douglas::vector::scale(b_vel, vel);
-        b_w->addVelocity(b_vel);
-        delete [] b_vel;
+        ((Player*) (*gos.begin()))->accelerate(-1 * accel, dt);
     });
-    input->listenTo('d', [&emptyWorld, &accel, &angle](double dt) -> void {
+    input->listenTo('d', [&emptyWorld, &angle](double dt) -> void {
         std::vector<GameObject*> gos;
         emptyWorld->getChildrenOfType(Player::TYPE, &gos);
-        Player* player = (Player*) (*gos.begin());
-        gos.clear();
-        player->getChildrenOfType(Wheel::TYPE, &gos);
-        std::vector<GameObject*>::iterator it = gos.begin();
-        ((Wheel*) (*it))->setAngle(angle);
+        ((Player*) (*gos.begin()))->steer(angle);
     });
-    input->listenTo('a', [&emptyWorld, &accel, &angle](double dt) -> void {
+    input->listenTo('a', [&emptyWorld, &angle](double dt) -> void {
         std::vector<GameObject*> gos;
         emptyWorld->getChildrenOfType(Player::TYPE, &gos);
-        Player* player = (Player*) (*gos.begin());
-        gos.clear();
-        player->getChildrenOfType(Wheel::TYPE, &gos);
-        std::vector<GameObject*>::iterator it = gos.begin();
-        ((Wheel*) (*it))->setAngle(-1 * angle);
+        ((Player*) (*gos.begin()))->steer(-1 * angle);
     });
     input->listen();
 
@@ -132,6 +96,7 @@ int main (int argc, char** argv) {
 
 	delete screen;
 	delete emptyWorld;
+	delete pool;
     input->end();
     delete input;
 
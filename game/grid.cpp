@@ -0,0 +1,128 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This file holds the source code for setting up and stepping the nine room grid of the game
+ */
+
+#include "grid.hpp"
+#include "spaces/grid_tiles.hpp"
+#include "../personal_utilities/vec_func.hpp"
+
+// Allocate the grid and fill it with every room
+// <w> and <h> are the size of each room in world units
+Room*** createGrid(double w, double h) {
+    Room* **grid = new Room**[3];
+    for(int i = 0; i < 3; i++) {
+        grid[i] = new Room*[3];
+    }
+    initializeGrid(grid, w, h);
+    return grid;
+}
+
+// Delete every room in the grid, including the player, and the grid itself
+void deleteGrid(Room* **grid) {
+    for(int i = 0; i < 3; i++) {
+        for(int j = 0; j < 3; j++) {
+            delete grid[i][j];
+        }
+        delete [] grid[i];
+    }
+    delete [] grid;
+}
+
+// Create the player at the start of the game, in the middle room and able to pick up the keys
+Player* createPlayer(Room* **grid) {
+    double * player_pos = douglas::vector::vector(20, 20);
+    Player* player = new Player(player_pos, 5.0, 10.0, 3.0, 100000.0, 100000.0);
+    delete [] player_pos;
+    grid[1][1]->setPlayer(player);
+    attachPlayerToKeys(grid, player);
+    return player;
+}
+
+// Whether key <k_int>, from 1 to 3, has been picked up
+bool checkKey(int k_int, Room* **grid) {
+    switch (k_int) {
+        case 1: {
+            return ((GridLM*) grid[0][1])->getKey()->getPickedUp();
+        }
+        case 2: {
+            return ((GridLT*) grid[0][0])->getKey()->getPickedUp();
+        }
+        case 3: {
+            return ((GridRT*) grid[2][0])->getKey()->getPickedUp();
+        }
+    }
+    return false;
+}
+
+// Let the keys' constraints see every particle of the player so it can pick them up
+void attachPlayerToKeys(Room* **grid, Player* player) {
+    std::vector<GameObject*>::iterator it;
+    std::vector<GameObject*> particles;
+    player->getChildrenOfType(Particle::TYPE, &particles);
+    for(it = particles.begin(); it != particles.end(); it++) {
+        Particle* p = (Particle*) *it;
+        ((GridLM*) grid[0][1])->getKey()->getKeyConstraint()->addParticle(p);
+        ((GridLT*) grid[0][0])->getKey()->getKeyConstraint()->addParticle(p);
+        ((GridRT*) grid[2][0])->getKey()->getKeyConstraint()->addParticle(p);
+    }
+}
+
+// Fill the grid with every room and connect each room to its neighbours
+void initializeGrid(Room* **grid, double w, double h) {
+    grid[0][0] = new GridLT(w, h);
+    grid[1][0] = new GridMT(w, h);
+    grid[2][0] = new GridRT(w, h);
+    grid[0][1] = new GridLM(w, h);
+    grid[1][1] = new GridMM(w, h);
+    grid[2][1] = new GridRM(w, h);
+    grid[0][2] = new GridLB(w, h);
+    grid[1][2] = new GridMB(w, h);
+    grid[2][2] = new GridRB(w, h);
+
+    for(int i = 0; i < 3; i++) {
+        for(int j = 0; j < 3; j++) {
+            if (i > 0) {
+                grid[i][j]->setSpace(3, grid[i - 1][j]);
+            }
+            if (i < 2) {
+                grid[i][j]->setSpace(1, grid[i + 1][j]);
+            }
+            if (j > 0) {
+                grid[i][j]->setSpace(0, grid[i][j - 1]);
+            }
+            if (j < 2) {
+                grid[i][j]->setSpace(2, grid[i][j + 1]);
+            }
+        }
+    }
+}
+
+// The room the player is in, nullptr if none of them have it
+Room* getPlayerRoom(Room* **grid) {
+    for(int i = 0; i < 3; i++) {
+        for(int j = 0; j < 3; j++) {
+            if (grid[i][j]->hasPlayer()) {
+                return grid[i][j];
+            }
+        }
+    }
+    return nullptr;
+}
+
+// Step every room at the same time on <pool>.  Returns once all the rooms are done, so moving the player between rooms
+// afterwards with checkPlayerLocation never happens while a room is being stepped.
+void stepRooms(Room* **grid, double dt, ThreadPool* pool) {
+    pool->parallelFor(9, [grid, dt](unsigned int i) {
+        grid[i % 3][i / 3]->step(dt);
+    });
+}
+
+// Light up the middle room's marker for each key that has been picked up
+void updateMarkers(Room* **grid) {
+    GridMM* gridMM = (GridMM*) grid[1][1];
+    gridMM->setMarker(1, checkKey(1, grid));
+    gridMM->setMarker(2, checkKey(2, grid));
+    gridMM->setMarker(3, checkKey(3, grid));
+}
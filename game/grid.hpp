@@ -0,0 +1,27 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This file holds the header for setting up and stepping the nine room grid of the game
+ */
+
+#ifndef FINAL_PROJECT_GRID_HPP
+#define FINAL_PROJECT_GRID_HPP
+
+#include "spaces/room.hpp"
+#include "player/player.hpp"
+#include "../personal_utilities/thread_pool.hpp"
+
+// The game is played in a 3x3 grid of Rooms, grid[i][j] is column i and row j from the top left.  These are shared by
+// the game and the headless runner so both play in exactly the same world.
+
+Room*** createGrid(double w, double h);
+void initializeGrid(Room***, double, double);
+void deleteGrid(Room***);
+Player* createPlayer(Room***);
+Room* getPlayerRoom(Room***);
+void stepRooms(Room***, double, ThreadPool*);
+void attachPlayerToKeys(Room***, Player*);
+bool checkKey(int, Room***);
+void updateMarkers(Room***);
+
+#endif //FINAL_PROJECT_GRID_HPP
@@ -6,8 +6,8 @@
 #include "../personal_utilities/vec_func.hpp"
 #include "../space.hpp"
 
-std::string Key::TYPE = "key";
-std::string Key::KeyConstraint::TYPE = "key_constraint";
+TypeId Key::TYPE = Typed::registerType("key");
+TypeId Key::KeyConstraint::TYPE = Typed::registerType("key_constraint");
 
 Key::Key(double *pos, double radius) : ParticleContainer() {
     addType(Key::TYPE);
@@ -22,42 +22,38 @@ Key::Key(double *pos, double radius) : ParticleContainer() {
 
 }
 
+// Render the key, it is only drawn again when it moves to a different render key or is picked up
 void Key::render(Screen *screen) {
-    if(changed) {
+    Space *world = (Space *) getWorld();
+    render_points.clear();
+    if(!picked_up) {
+        render_points.push_back(world->convertToPixels(key_p, screen));
+    }
+
+    if(renderKeyChanged()) {
         rendered_pixels.clear();
 
         if(!picked_up) {
-            double *top_pos = douglas::vector::copy(key_p->getPosition());
-            top_pos[1] += 2.5;
-            double *middle_pos = douglas::vector::copy(key_p->getPosition());
-            middle_pos[1] -= 1.0;
-            double *middle_left_pos = douglas::vector::copy(middle_pos);
-            middle_left_pos[0] += 1.5;
-            double *bottom_pos = douglas::vector::copy(key_p->getPosition());
-            bottom_pos[1] -= 2.5;
-            double *bottom_left_pos = douglas::vector::copy(bottom_pos);
-            bottom_left_pos[0] += 1.5;
-            double *circle_top_left = douglas::vector::copy(top_pos);
-            circle_top_left[0] -= 1.5;
-            circle_top_left[1] += 3.0;
-            double *circle_top_right = douglas::vector::copy(circle_top_left);
-            circle_top_right[0] += 3.0;
-            double *circle_bottom_left = douglas::vector::copy(circle_top_left);
-            circle_bottom_left[1] -= 3.0;
-            double *circle_bottom_right = douglas::vector::copy(circle_top_right);
-            circle_bottom_right[1] -= 3.0;
-
-
-            Space *world = (Space *) getWorld();
-            world->convertToPixels(top_pos, screen);
-            world->convertToPixels(middle_pos, screen);
-            world->convertToPixels(middle_left_pos, screen);
-            world->convertToPixels(bottom_left_pos, screen);
-            world->convertToPixels(bottom_pos, screen);
-            world->convertToPixels(circle_bottom_left, screen);
-            world->convertToPixels(circle_bottom_right, screen);
-            world->convertToPixels(circle_top_left, screen);
-            world->convertToPixels(circle_top_right, screen);
+            douglas::Vec2 pos = key_p->getRenderPosition();
+            douglas::Vec2 top_pos = pos + douglas::Vec2(0, 2.5);
+            douglas::Vec2 middle_pos = pos + douglas::Vec2(0, -1.0);
+            douglas::Vec2 middle_left_pos = middle_pos + douglas::Vec2(1.5, 0);
+            douglas::Vec2 bottom_pos = pos + douglas::Vec2(0, -2.5);
+            douglas::Vec2 bottom_left_pos = bottom_pos + douglas::Vec2(1.5, 0);
+            douglas::Vec2 circle_top_left = top_pos + douglas::Vec2(-1.5, 3.0);
+            douglas::Vec2 circle_top_right = circle_top_left + douglas::Vec2(3.0, 0);
+            douglas::Vec2 circle_bottom_left = circle_top_left + douglas::Vec2(0, -3.0);
+            douglas::Vec2 circle_bottom_right = circle_top_right + douglas::Vec2(0, -3.0);
+
+            top_pos = world->convertToPixels(top_pos, screen);
+            middle_pos = world->convertToPixels(middle_pos, screen);
+            middle_left_pos = world->convertToPixels(middle_left_pos, screen);
+            bottom_left_pos = world->convertToPixels(bottom_left_pos, screen);
+            bottom_pos = world->convertToPixels(bottom_pos, screen);
+            circle_bottom_left = world->convertToPixels(circle_bottom_left, screen);
+            circle_bottom_right = world->convertToPixels(circle_bottom_right, screen);
+            circle_top_left = world->convertToPixels(circle_top_left, screen);
+            circle_top_right = world->convertToPixels(circle_top_right, screen);
 
             screen->line(bottom_pos, top_pos, draw_char, &rendered_pixels);
             screen->line(middle_pos, middle_left_pos, draw_char, &rendered_pixels);
@@ -66,16 +62,6 @@ void Key::render(Screen *screen) {
             screen->line(circle_top_left, circle_bottom_left, draw_char, &rendered_pixels);
             screen->line(circle_bottom_right, circle_bottom_left, draw_char, &rendered_pixels);
             screen->line(circle_bottom_right, circle_top_right, draw_char, &rendered_pixels);
-
-            delete [] top_pos;
-            delete [] middle_pos;
-            delete [] middle_left_pos;
-            delete [] bottom_left_pos;
-            delete [] bottom_pos;
-            delete [] circle_bottom_left;
-            delete [] circle_bottom_right;
-            delete [] circle_top_left;
-            delete [] circle_top_right;
         }
     }
 
@@ -90,7 +76,7 @@ Key::KeyConstraint::KeyConstraint(Key *key) : SingleConstraint() {
 void Key::KeyConstraint::fix(int iter, Particle *p) {
     if(!this->key->picked_up) {
         if(key->getWorld() == p->getWorld()) {
-            double dist = douglas::vector::distance(p->getPosition(), this->key->key_p->getPosition());
+            double dist = p->getPosition().distance(this->key->key_p->getPosition());
             if (dist < this->key->radius) {
                 this->key->setPickedUp(true);
             }
@@ -14,7 +14,7 @@ public:
     protected:
         Key* key;
     public:
-        static std::string TYPE;
+        static TypeId TYPE;
         KeyConstraint(Key* key);
         void fix(int iter, Particle* p);
     };
@@ -26,7 +26,7 @@ protected:
     KeyConstraint* keyConstraint;
 
 public:
-    static std::string TYPE;
+    static TypeId TYPE;
 
     Key(double * pos, double radius);
 
@@ -6,8 +6,10 @@
 
 #include "player.hpp"
 #include "../../space.hpp"
+#include "../../personal_utilities/vec_func.hpp"
+#include <algorithm>
 
-std::string Player::TYPE = "player_car";
+TypeId Player::TYPE = Typed::registerType("player_car");
 
 // Default player constructor.
 // <pos> refers to the center position of the player
@@ -75,34 +77,49 @@ Player::Player(double * pos,
 
 // Return the middle of the player.  This function assumes that the car is in a good state due to its constraints
 // as the midpoint is calculated by the intersection of the diagonal lines made by the midpoints of the front and back
-// wheels of the player (car).
-double* Player::getPlayerMidPoint() {
-    double * intersect = douglas::vector::intersection(((Particle*) frontWheels->getChildren()[1])->getPosition(),
-                                                       ((Particle*) backWheels->getChildren()[4])->getPosition(),
-                                                       ((Particle*) frontWheels->getChildren()[4])->getPosition(),
-                                                       ((Particle*) backWheels->getChildren()[1])->getPosition());
-    return intersect;
+// wheels of the player (car).  If the car is twisted so the diagonals do not cross the average of the four is used.
+douglas::Vec2 Player::getPlayerMidPoint() {
+    douglas::Vec2 f_l = ((Particle*) frontWheels->getChildren()[1])->getPosition();
+    douglas::Vec2 f_r = ((Particle*) frontWheels->getChildren()[4])->getPosition();
+    douglas::Vec2 b_l = ((Particle*) backWheels->getChildren()[1])->getPosition();
+    douglas::Vec2 b_r = ((Particle*) backWheels->getChildren()[4])->getPosition();
+    douglas::Intersection intersect = douglas::intersection(f_l, b_r, f_r, b_l);
+    if(intersect) {
+        return intersect.point;
+    }
+    return (f_l + f_r + b_l + b_r) * 0.25;
 }
 
 // Move all the particles in the player by dx and dy.  This is used for jumping between Rooms.
 void Player::movePlayerBy(double dx, double dy) {
+    douglas::Vec2 d(dx, dy);
     std::vector<GameObject*>::iterator g_it;
     std::vector<GameObject*> particles;
     getChildrenOfType(Particle::TYPE, &particles);
     for(g_it = particles.begin(); g_it != particles.end(); g_it++) {
-        double * n_pos = douglas::vector::copy(((Particle*) *g_it)->getPosition());
-        n_pos[0] += dx;
-        n_pos[1] += dy;
-        double * n_ppos = douglas::vector::copy(((Particle*) *g_it)->getPPosition());
-        n_ppos[0] += dx;
-        n_ppos[1] += dy;
-        ((Particle*) *g_it)->setPosition(n_pos);
-        ((Particle*) *g_it)->setPPosition(n_ppos);
-        delete [] n_pos;
-        delete [] n_ppos;
+        Particle* p = (Particle*) *g_it;
+        p->setPosition(p->getPosition() + d);
+        p->setPPosition(p->getPPosition() + d);
     }
 }
 
+// Push the car forwards, or backwards when <accel> is negative, by adding velocity to the back wheels
+// <accel> is the acceleration along the direction the back wheels point
+// <dt> is the time the push lasts, a frame longer than 0.1 seconds is treated as a stall and only gets a small push
+// <step> is the physics step that velocity is measured in, zero when it is the same as <dt>
+void Player::accelerate(double accel, double dt, double step) {
+    if (step <= 0) {
+        step = dt;
+    }
+    double vel = accel * (std::min(dt, 0.1) * std::min(step, 0.1));
+    backWheels->addVelocity(backWheels->getWheelVector().unit() * vel);
+}
+
+// Turn the front wheels to <angle> radians from straight ahead, positive turns right
+void Player::steer(double angle) {
+    frontWheels->setAngle(angle);
+}
+
 // Render function for the car.  Renders only the middle connecting lines of the car between the front and back
 // wheels as the front and back wheels render themselves.  The render consists of a straight line between the centers
 // of the wheels and two diagonal lines forming a triangle pointing to the front wheels to make moving the car
@@ -112,42 +129,36 @@ void Player::render(Screen *screen) {
 
     renderChildren(screen);
 
-    if(changed) {
-        rendered_pixels.clear();
+    // The lines only depend on the two ends of each wheel's axle
+    Space* space = (Space*) getWorld();
+    Particle* axles[4] = { frontWheels->getParticle(1), frontWheels->getParticle(4),
+                           backWheels->getParticle(1), backWheels->getParticle(4) };
+    render_points.clear();
+    space->convertToPixels(axles, 4, &render_points, screen);
 
-        double * front_diff = douglas::vector::subtract(((Particle*) frontWheels->getChildren()[4])->getPosition(),
-                                                        ((Particle*) frontWheels->getChildren()[1])->getPosition());
-        douglas::vector::scale(front_diff, 0.5);
-        double * front_mid = douglas::vector::add(front_diff, ((Particle*) frontWheels->getChildren()[1])->getPosition());
+    if(renderKeyChanged()) {
+        rendered_pixels.clear();
 
+        douglas::Vec2 front_l = axles[0]->getRenderPosition();
+        douglas::Vec2 front_mid = front_l + ((axles[1]->getRenderPosition() - front_l) * 0.5);
 
-        double * back_diff = douglas::vector::subtract(((Particle*) backWheels->getChildren()[4])->getPosition(),
-                                                       ((Particle*) backWheels->getChildren()[1])->getPosition());
-        douglas::vector::scale(back_diff, 0.5);
-        double * back_mid = douglas::vector::add(back_diff, ((Particle*) backWheels->getChildren()[1])->getPosition());
+        douglas::Vec2 back_l = axles[2]->getRenderPosition();
+        douglas::Vec2 back_diff = (axles[3]->getRenderPosition() - back_l) * 0.5;
+        douglas::Vec2 back_mid = back_l + back_diff;
 
-        douglas::vector::scale(back_diff, 0.5);
-        double * back_l_mid = douglas::vector::add(back_diff, back_mid);
-        douglas::vector::scale(back_diff, -1.0);
-        double * back_r_mid = douglas::vector::add(back_diff, back_mid);
+        back_diff *= 0.5;
+        douglas::Vec2 back_l_mid = back_mid + back_diff;
+        douglas::Vec2 back_r_mid = back_mid - back_diff;
 
-        Space* space = (Space*) getWorld();
-        space->convertToPixels(front_mid, screen);
-        space->convertToPixels(back_mid, screen);
-        space->convertToPixels(back_l_mid, screen);
-        space->convertToPixels(back_r_mid, screen);
+        front_mid = space->convertToPixels(front_mid, screen);
+        back_mid = space->convertToPixels(back_mid, screen);
+        back_l_mid = space->convertToPixels(back_l_mid, screen);
+        back_r_mid = space->convertToPixels(back_r_mid, screen);
 
         screen->line(front_mid, back_mid, draw_char, &rendered_pixels);
         screen->line(front_mid, back_l_mid, draw_char, &rendered_pixels);
         screen->line(front_mid, back_r_mid, draw_char, &rendered_pixels);
 
-        delete [] front_mid;
-        delete [] front_diff;
-        delete [] back_mid;
-        delete [] back_diff;
-        delete [] back_l_mid;
-        delete [] back_r_mid;
-
     }
 
     screen->addToFrame(rendered_pixels);
@@ -26,7 +26,7 @@ private:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     Player(double * pos,
            double width,
@@ -49,9 +49,12 @@ public:
     char getDrawChar() { return draw_char; }
     void setDrawChar(char c) { this->draw_char = c; frontWheels->setDrawChar(c); backWheels->setDrawChar(c); }
 
-    double * getPlayerMidPoint();
+    douglas::Vec2 getPlayerMidPoint();
     void movePlayerBy(double dx, double dy);
 
+    void accelerate(double accel, double dt, double step = 0);
+    void steer(double angle);
+
     void render(Screen* screen);
 
 };
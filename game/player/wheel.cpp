@@ -8,8 +8,8 @@
 #include <cmath>
 #include "../../space.hpp"
 
-std::string Wheel::TYPE = "wheel";
-std::string Wheel::WheelConstraint::TYPE = "wheel_constraint";
+TypeId Wheel::TYPE = Typed::registerType("wheel");
+TypeId Wheel::WheelConstraint::TYPE = Typed::registerType("wheel_constraint");
 
 // Constructor for the Wheel.
 // <pos> defines the center of the wheel
@@ -207,32 +207,26 @@ void Wheel::changeAngle(double d_angle) {
 }
 
 // Return the current vector of one of the wheels, as they are always parallel they are the same.
-double* Wheel::getWheelVector() {
-    return douglas::vector::subtract(((Particle*) children[0])->getPosition(),
-                                     ((Particle*) children[1])->getPosition());
+douglas::Vec2 Wheel::getWheelVector() {
+    return ((Particle*) children[0])->getPosition() - ((Particle*) children[1])->getPosition();
 }
 
-// Render the wheel, each of the wheels and then a line connecting their midpoints.
+// Render the wheel, each of the wheels and then a line connecting their midpoints.  The lines are only drawn again
+// when one of the six particles has moved.
 void Wheel::render(Screen * screen) {
-    if(changed) {
-        rendered_pixels.clear();
+    Space* world = (Space*) getWorld();
+    Particle* particles[6];
+    for(unsigned int i = 0; i < 6; i++) {
+        particles[i] = (Particle*) children[i];
+    }
+    render_points.clear();
+    world->convertToPixels(particles, 6, &render_points, screen);
 
-        Space* world = (Space*) getWorld();
-        double * p0 = world->convertToPixels((Particle*) getChildren()[0], screen);
-        double * p1 = world->convertToPixels((Particle*) getChildren()[1], screen);
-        double * p2 = world->convertToPixels((Particle*) getChildren()[2], screen);
-        double * p3 = world->convertToPixels((Particle*) getChildren()[3], screen);
-        double * p4 = world->convertToPixels((Particle*) getChildren()[4], screen);
-        double * p5 = world->convertToPixels((Particle*) getChildren()[5], screen);
-        screen->line(p1, p4, draw_char, &rendered_pixels);
-        screen->line(p0, p2, draw_char, &rendered_pixels);
-        screen->line(p3, p5, draw_char, &rendered_pixels);
-        delete [] p0;
-        delete [] p1;
-        delete [] p2;
-        delete [] p3;
-        delete [] p4;
-        delete [] p5;
+    if(renderKeyChanged()) {
+        rendered_pixels.clear();
+        screen->line(render_points[1], render_points[4], draw_char, &rendered_pixels);
+        screen->line(render_points[0], render_points[2], draw_char, &rendered_pixels);
+        screen->line(render_points[3], render_points[5], draw_char, &rendered_pixels);
     }
 
     screen->addToFrame(rendered_pixels);
@@ -240,8 +234,8 @@ void Wheel::render(Screen * screen) {
 }
 
 // Update the wheels attributes
-void Wheel::step(double dt) {
-    ParticleContainer::step(dt);
+void Wheel::update(double dt) {
+    ParticleContainer::update(dt);
     // If the current angle has been help for a certain amount of time set it back to zero
     if((std::chrono::high_resolution_clock::now() - last_angle_change).count() / 1000000.0 > hold_angle_milliseconds) {
         setAngle(0);
@@ -254,94 +248,38 @@ Wheel::WheelConstraint::WheelConstraint(double drag_coefficient) : PairConstrain
     this->drag_coefficient = drag_coefficient;
 }
 
+// Slow down the part of a particle's velocity along <resistance>, proportionally to the square of that velocity
+// <drag_coefficient> is the WheelConstraint's drag coefficient
+static void resistSideways(Particle * p, const douglas::Vec2 &resistance, double drag_coefficient) {
+    // Calculate the amount of velocity parallel to the resistance vector
+    douglas::Vec2 res_vel = (p->getPosition() - p->getPPosition()).project(resistance);
+
+    if (res_vel.magnitude() != 0) {
+        // Square each of the components
+        douglas::Vec2 tmp(res_vel.x * std::abs(res_vel.x), res_vel.y * std::abs(res_vel.y));
+        // Scale the factor by the drag coefficient, time squared, and inverse mass to get displacement, reversed to
+        // be opposite of velocity
+        tmp *= -1.0 * (drag_coefficient * p->getPreviousStepTime()) / p->getMass();
+        // Calculate the new position
+        douglas::Vec2 diff = tmp.project(resistance);
+        if(diff.magnitude() > res_vel.magnitude()) {
+            p->setPosition(p->getPosition() - res_vel);
+        } else {
+            p->setPosition(p->getPosition() + diff);
+        }
+    }
+}
+
 // Method that applies the necessary changes to the two particles provided in accordance with the constraint
 void Wheel::WheelConstraint::fix(int iter, Particle * p1, Particle * p2) {
 
     // Only apply constraint on the first iteration
     if ( iter < 2 ) {
-        // Calculate the two velocities
-        double *vel1 = douglas::vector::subtract(p1->getPosition(), p1->getPPosition());
-        double *vel2 = douglas::vector::subtract(p2->getPosition(), p2->getPPosition());
-
-        // Calculate the vector along the wheel
-        double *wheelVector = douglas::vector::subtract(p1->getPosition(), p2->getPosition());
         // Calculate the vector orthogonal to the wheel
-        double *resistanceVector = douglas::vector::vector(-wheelVector[1], wheelVector[0]);
-
-        // Calculate the amount of velocity parallel to the resistance vector
-        double *res_vel1 = douglas::vector::project(vel1, resistanceVector);
-        double *res_vel2 = douglas::vector::project(vel2, resistanceVector);
-
-        if (douglas::vector::magnitude(res_vel1) != 0) {
-            // Tmp container for calculations
-            double * tmp = douglas::vector::copy(res_vel1);
-            // Square each of the components
-            tmp[0] *= std::abs(res_vel1[0]);
-            tmp[1] *= std::abs(res_vel1[1]);
-            // Get the previous delta time for the particle
-            double p_dt = p1->getPreviousStepTime();
-            // Scale the factor by the drag coefficient, time squared, and inverse mass to get displacement
-            douglas::vector::scale(tmp, (this->drag_coefficient * p_dt) / p1->getMass());
-            // Reverse vector to be opposite of velocity
-            douglas::vector::scale(tmp, -1.0);
-            // Calculate the new position
-            double *diff = douglas::vector::project(tmp, resistanceVector);
-            if(douglas::vector::magnitude(diff) > douglas::vector::magnitude(res_vel1)) {
-                douglas::vector::scale(res_vel1, -1.0);
-                double *n_pos = douglas::vector::add(p1->getPosition(), res_vel1);
-                // Set the new position
-                p1->setPosition(n_pos);
-                // Delete all the old variables
-                delete [] n_pos;
-            } else {
-                double *n_pos = douglas::vector::add(p1->getPosition(), diff);
-                // Set the new position
-                p1->setPosition(n_pos);
-                // Delete all the old variables
-                delete [] n_pos;
-            }
-            delete [] tmp;
-            delete [] diff;
-        }
-        if (douglas::vector::magnitude(res_vel2) != 0) {
-            // Tmp container for calculations
-            double * tmp = douglas::vector::copy(res_vel2);
-            // Square each of the components
-            tmp[0] *= std::abs(res_vel2[0]);
-            tmp[1] *= std::abs(res_vel2[1]);
-            // Get the previous delta time for the particle
-            double p_dt = p2->getPreviousStepTime();
-            // Scale the factor by the drag coefficient, time squared, and inverse mass to get displacement
-            douglas::vector::scale(tmp, (this->drag_coefficient * p_dt) / p2->getMass());
-            // Reverse vector to be opposite of velocity
-            douglas::vector::scale(tmp, -1.0);
-            // Calculate the new position
-            double *diff = douglas::vector::project(tmp, resistanceVector);
-            if(douglas::vector::magnitude(diff) > douglas::vector::magnitude(res_vel2)) {
-                douglas::vector::scale(res_vel2, -1.0);
-                double *n_pos = douglas::vector::add(p2->getPosition(), res_vel2);
-                // Set the new position
-                p2->setPosition(n_pos);
-                // Delete all the old variables
-                delete [] n_pos;
-            } else {
-                double *n_pos = douglas::vector::add(p2->getPosition(), diff);
-                // Set the new position
-                p2->setPosition(n_pos);
-                // Delete all the old variables
-                delete[] n_pos;
-            }
-            delete [] tmp;
-            delete [] diff;
-        }
+        douglas::Vec2 resistanceVector = (p1->getPosition() - p2->getPosition()).orthogonal();
 
-        // Delete all the vectors
-        delete [] vel1;
-        delete [] vel2;
-        delete [] wheelVector;
-        delete [] resistanceVector;
-        delete [] res_vel1;
-        delete [] res_vel2;
+        resistSideways(p1, resistanceVector, drag_coefficient);
+        resistSideways(p2, resistanceVector, drag_coefficient);
     }
 
-}
\ No newline at end of file
+}
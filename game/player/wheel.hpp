@@ -9,7 +9,7 @@
 
 #include "../../physics/particle_container.hpp"
 #include "../../physics/constraints/line_constraint.hpp"
-#include "../../personal_utilities/vec_func.hpp"
+#include "../../personal_utilities/vec2.hpp"
 #include <chrono>
 
 // The Wheel class represents two wheels connected by an axel.  There is a constraint of each of the wheels that
@@ -21,7 +21,7 @@ class Wheel : public ParticleContainer {
     private:
         double drag_coefficient;
     public:
-        static std::string TYPE;
+        static TypeId TYPE;
 
         WheelConstraint(double drag_coefficient);
 
@@ -48,7 +48,7 @@ private:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     // Position defines center
     Wheel(double * pos, double width, double height, double angle, double drag_coefficient);
@@ -65,10 +65,12 @@ public:
     char getDrawChar() { return draw_char; }
     void setDrawChar(char c) { this->draw_char = c; }
 
-    double * getWheelVector();
+    douglas::Vec2 getWheelVector();
+    // One of the six particles of the wheel, 1 and 4 are the ends of the axle
+    Particle* getParticle(unsigned int i) { return (Particle*) children[i]; }
 
     void render(Screen*);
-    void step(double dt);
+    void update(double dt);
 
 };
 
@@ -5,9 +5,10 @@
  */
 
 #include "grid_l_b.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 
 // Type declaration
-std::string GridLB::TYPE = "grid_left_bottom";
+TypeId GridLB::TYPE = Typed::registerType("grid_left_bottom");
 
 // Default constructor
 GridLB::GridLB(double u_w, double u_h) : Room(u_w, u_h) {
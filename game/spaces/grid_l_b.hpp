@@ -25,7 +25,7 @@ protected:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
     constexpr static int RELAXATION_ROUNDS = 5;
 
     GridLB(double u_w, double u_h);
@@ -5,9 +5,10 @@
  */
 
 #include "grid_l_m.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 
 // Type declaration
-std::string GridLM::TYPE = "grid_left_middle";
+TypeId GridLM::TYPE = Typed::registerType("grid_left_middle");
 
 // Default constructor
 GridLM::GridLM(double u_w, double u_h) : Room(u_w, u_h) {
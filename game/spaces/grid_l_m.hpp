@@ -42,7 +42,7 @@ protected:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
     constexpr static int RELAXATION_ROUNDS = 5;
 
     GridLM(double u_w, double u_h);
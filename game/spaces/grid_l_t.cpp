@@ -5,9 +5,10 @@
  */
 
 #include "grid_l_t.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 
 // Type declaration
-std::string GridLT::TYPE = "grid_left_top";
+TypeId GridLT::TYPE = Typed::registerType("grid_left_top");
 
 // Default constructor
 GridLT::GridLT(double u_w, double u_h) : Room(u_w, u_h) {
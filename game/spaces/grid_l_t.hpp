@@ -24,7 +24,7 @@ protected:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
     constexpr static int RELAXATION_ROUNDS = 5;
 
     GridLT(double u_w, double u_h);
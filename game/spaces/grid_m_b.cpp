@@ -5,9 +5,10 @@
  */
 
 #include "grid_m_b.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 
 // Type declaration
-std::string GridMB::TYPE = "grid_middle_bottom";
+TypeId GridMB::TYPE = Typed::registerType("grid_middle_bottom");
 
 // Default constructor
 GridMB::GridMB(double u_w, double u_h) : Room(u_w, u_h) {
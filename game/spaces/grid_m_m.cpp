@@ -5,9 +5,10 @@
  */
 
 #include "grid_m_m.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 
 // Type declaration
-std::string GridMM::TYPE = "grid_middle_middle";
+TypeId GridMM::TYPE = Typed::registerType("grid_middle_middle");
 
 // Default constructor
 GridMM::GridMM(double u_w, double u_h) : Room(u_w, u_h) {
@@ -102,6 +103,19 @@ void GridMM::step(double dt) {
     handlePhysics(GridMM::RELAXATION_ROUNDS);
 }
 
+// Draws the box on the floor that the markers are shown in, it never moves so it is part of the background
+void GridMM::renderBackground(Screen *screen, std::vector<Pixel> *vec) {
+    douglas::Vec2 t_l = convertToPixels(douglas::Vec2((unit_width / 3.0), unit_height - (unit_height / 3.0)), screen);
+    douglas::Vec2 t_r = convertToPixels(douglas::Vec2(unit_width - (unit_width / 3.0), unit_height - (unit_height / 3.0)), screen);
+    douglas::Vec2 b_r = convertToPixels(douglas::Vec2(unit_width - (unit_width / 3.0), (unit_height / 3.0)), screen);
+    douglas::Vec2 b_l = convertToPixels(douglas::Vec2((unit_width / 3.0), (unit_height / 3.0)), screen);
+
+    screen->line(t_l, t_r, '.', vec);
+    screen->line(b_l, b_r, '.', vec);
+    screen->line(t_l, b_l, '.', vec);
+    screen->line(t_r, b_r, '.', vec);
+}
+
 // Renders the space
 void GridMM::render(Screen *screen) {
 
@@ -116,62 +130,28 @@ void GridMM::render(Screen *screen) {
     screen->printValue(16,"            the walls.");
     screen->printValue(18," Movement:  WASD keys");
 
-    double * t_l = douglas::vector::vector((unit_width / 3.0), unit_height - (unit_height / 3.0));
-    double * t_r = douglas::vector::vector(unit_width - (unit_width / 3.0), unit_height - (unit_height / 3.0));
-    double * b_r = douglas::vector::vector(unit_width - (unit_width / 3.0), (unit_height / 3.0));
-    double * b_l = douglas::vector::vector((unit_width / 3.0), (unit_height / 3.0));
+    // The markers are drawn before the children, so the background has to be in place first
+    drawBackground(screen);
 
     Space* world = (Space*) getWorld();
-    world->convertToPixels(t_l, screen);
-    world->convertToPixels(t_r, screen);
-    world->convertToPixels(b_r, screen);
-    world->convertToPixels(b_l, screen);
-
-    std::vector<Pixel> box;
-    screen->line(t_l, t_r, '.', &box);
-    screen->line(b_l, b_r, '.', &box);
-    screen->line(t_l, b_l, '.', &box);
-    screen->line(t_r, b_r, '.', &box);
-    screen->addToFrame(box);
-
-    std::vector<Pixel> ticks;
     if(show_marker_1) {
-        double * p1 = douglas::vector::vector((unit_width / 2.5), unit_height - (unit_height / 2.5));
-        double * p2 = douglas::vector::vector((unit_width / 2.5), (unit_height / 2.5));
-        world->convertToPixels(p1, screen);
-        world->convertToPixels(p2, screen);
-        screen->line(p1, p2, '.', &ticks);
-        delete [] p1;
-        delete [] p2;
+        douglas::Vec2 p1 = world->convertToPixels(douglas::Vec2((unit_width / 2.5), unit_height - (unit_height / 2.5)), screen);
+        douglas::Vec2 p2 = world->convertToPixels(douglas::Vec2((unit_width / 2.5), (unit_height / 2.5)), screen);
+        screen->drawLine(p1, p2, '.');
     }
 
     if(show_marker_2) {
-        double * p1 = douglas::vector::vector((unit_width / 2.0), unit_height - (unit_height / 2.5));
-        double * p2 = douglas::vector::vector((unit_width / 2.0), (unit_height / 2.5));
-        world->convertToPixels(p1, screen);
-        world->convertToPixels(p2, screen);
-        screen->line(p1, p2, '.', &ticks);
-        delete [] p1;
-        delete [] p2;
+        douglas::Vec2 p1 = world->convertToPixels(douglas::Vec2((unit_width / 2.0), unit_height - (unit_height / 2.5)), screen);
+        douglas::Vec2 p2 = world->convertToPixels(douglas::Vec2((unit_width / 2.0), (unit_height / 2.5)), screen);
+        screen->drawLine(p1, p2, '.');
     }
 
     if(show_marker_3) {
-        double * p1 = douglas::vector::vector(unit_width - (unit_width / 2.5), unit_height - (unit_height / 2.5));
-        double * p2 = douglas::vector::vector(unit_width - (unit_width / 2.5), (unit_height / 2.5));
-        world->convertToPixels(p1, screen);
-        world->convertToPixels(p2, screen);
-        screen->line(p1, p2, '.', &ticks);
-        delete [] p1;
-        delete [] p2;
+        douglas::Vec2 p1 = world->convertToPixels(douglas::Vec2(unit_width - (unit_width / 2.5), unit_height - (unit_height / 2.5)), screen);
+        douglas::Vec2 p2 = world->convertToPixels(douglas::Vec2(unit_width - (unit_width / 2.5), (unit_height / 2.5)), screen);
+        screen->drawLine(p1, p2, '.');
     }
 
-    screen->addToFrame(ticks);
-
-    delete [] t_l;
-    delete [] t_r;
-    delete [] b_r;
-    delete [] b_l;
-
     // Renders all the children
     renderChildren(screen);
 }
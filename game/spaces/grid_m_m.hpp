@@ -25,13 +25,14 @@ protected:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
     constexpr static int RELAXATION_ROUNDS = 5;
 
     GridMM(double u_w, double u_h);
 
     void setup();
     void step(double dt);
+    void renderBackground(Screen* screen, std::vector<Pixel>* vec);
     void render(Screen* screen);
 
     void setMarker(int i, bool b);
@@ -5,10 +5,11 @@
  */
 
 #include "grid_m_t.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 #include <cmath>
 
 // Type declaration
-std::string GridMT::TYPE = "grid_middle_top";
+TypeId GridMT::TYPE = Typed::registerType("grid_middle_top");
 
 // Default constructor
 GridMT::GridMT(double u_w, double u_h) : Room(u_w, u_h) {
@@ -5,9 +5,10 @@
  */
 
 #include "grid_r_b.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 
 // Type declaration
-std::string GridRB::TYPE = "grid_right_bottom";
+TypeId GridRB::TYPE = Typed::registerType("grid_right_bottom");
 
 // Default constructor
 GridRB::GridRB(double u_w, double u_h) : Room(u_w, u_h) {
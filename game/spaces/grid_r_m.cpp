@@ -5,9 +5,10 @@
  */
 
 #include "grid_r_m.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 
 // Type declaration
-std::string GridRM::TYPE = "grid_right_middle";
+TypeId GridRM::TYPE = Typed::registerType("grid_right_middle");
 
 // Default constructor
 GridRM::GridRM(double u_w, double u_h) : Room(u_w, u_h) {
@@ -5,9 +5,10 @@
  */
 
 #include "grid_r_t.hpp"
+#include "../../personal_utilities/vec_func.hpp"
 
 // Type declaration
-std::string GridRT::TYPE = "grid_right_top";
+TypeId GridRT::TYPE = Typed::registerType("grid_right_top");
 
 // Default constructor
 GridRT::GridRT(double u_w, double u_h) : Room(u_w, u_h) {
@@ -4,7 +4,7 @@
 
 #include "room.hpp"
 
-std::string Room::TYPE = "room";
+TypeId Room::TYPE = Typed::registerType("room");
 
 Room::Room(double u_w, double u_h) : Space(u_w, u_h) {
     addType(Room::TYPE);
@@ -24,18 +24,18 @@ void Room::removePlayer() {
 
 void Room::checkPlayerLocation() {
     if (player != nullptr) {
-        double * p_mid = player->getPlayerMidPoint();
+        douglas::Vec2 p_mid = player->getPlayerMidPoint();
 
-        if(p_mid[1] >= 0 && p_mid[1] < unit_height) {
+        if(p_mid.y >= 0 && p_mid.y < unit_height) {
             // Signifies either right or left side
-            if(p_mid[0] < 0) {
+            if(p_mid.x < 0) {
                 // Signifies left side
                 if(neighbors[3] != nullptr) {
                     player->movePlayerBy(neighbors[3]->getWidth() - 1, 0);
                     ((Room*) neighbors[3])->setPlayer(player);
                     removePlayer();
                 }
-            } else if (p_mid[0] >= unit_width) {
+            } else if (p_mid.x >= unit_width) {
                 // Signifies right side
                 if(neighbors[1] != nullptr) {
                     player->movePlayerBy( -1 * (unit_width - 1), 0);
@@ -43,16 +43,16 @@ void Room::checkPlayerLocation() {
                     removePlayer();
                 }
             }
-        } else if (p_mid[0] >= 0 && p_mid[0] < unit_width) {
+        } else if (p_mid.x >= 0 && p_mid.x < unit_width) {
             // Signifies either top or bottom side
-            if(p_mid[1] < 0) {
+            if(p_mid.y < 0) {
                 // Signifies bottom side
                 if(neighbors[2] != nullptr) {
                     player->movePlayerBy(0, neighbors[2]->getHeight() - 1);
                     ((Room*) neighbors[2])->setPlayer(player);
                     removePlayer();
                 }
-            } else if (p_mid[1] >= unit_height) {
+            } else if (p_mid.y >= unit_height) {
                 // Signifies top side
                 if(neighbors[0] != nullptr) {
                     player->movePlayerBy(0, -1 * (unit_height - 1));
@@ -61,7 +61,5 @@ void Room::checkPlayerLocation() {
                 }
             }
         }
-
-        delete [] p_mid;
     }
 }
\ No newline at end of file
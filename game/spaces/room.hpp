@@ -16,7 +16,7 @@ protected:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     Room(double u_w, double u_h);
 
@@ -10,25 +10,44 @@
 #include <thread>
 #include "personal_utilities/vec_func.hpp"
 #include "personal_utilities/douglbre_util.hpp"
+#include "personal_utilities/thread_pool.hpp"
 #include "display/screen.hpp"
+#include "display/frame_stats.hpp"
 #include "game_object.hpp"
 #include "physics/objects/box.hpp"
 #include "game/player/wheel.hpp"
 #include "game/player/player.hpp"
 #include "input.hpp"
+#include "trace.hpp"
+#include "simulation_clock.hpp"
 
 #include "game/spaces/room.hpp"
 #include "game/spaces/grid_tiles.hpp"
+#include "game/grid.hpp"
 
-void initializeGrid(Room***, double, double);
-Room* getPlayerRoom(Room***);
-void stepRooms(Room***, double);
 void printEnding(bool state);
-void attachPlayerToKeys(Room***, Player*);
-bool checkKey(int, Room***);
 
 int main (int argc, char** argv) {
 
+    // "--record <file>" records every frame of the game to a file, "--replay <file>" plays a recording back and
+    // "--trace <file>" writes where the time of each frame went to a Chrome trace when the game ends
+    std::string record_path;
+    std::string trace_path;
+    for(int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if(arg == "--replay") {
+            TerminalSink terminal;
+            RecorderSink::replay(argv[i + 1], &terminal, true);
+            std::cout << std::endl << std::endl;
+            return 0;
+        } else if(arg == "--record") {
+            record_path = argv[i + 1];
+        } else if(arg == "--trace") {
+            trace_path = argv[i + 1];
+            Trace::setEnabled(true);
+        }
+    }
+
     // These define the size of the game worlds, in arbitrary units.
     double world_width = 100.0;
     double world_height = 50.0;
@@ -86,24 +105,18 @@ int main (int argc, char** argv) {
 
     std::cout << std::endl << "Press 'q' to quit." << std::endl;
 
-    // create double array of space pointers
-    Room* **grid = new Room**[3];
-    for(int i = 0; i < 3; i++) {
-        grid[i] = new Room*[3];
-    }
-    // fill grid with the correct instances
-    initializeGrid(grid, world_width, world_height);
+    // create double array of space pointers filled with the correct instances
+    Room* **grid = createGrid(world_width, world_height);
 
     // Create the player
-    double * player_pos = douglas::vector::vector(20, 20);
-    Player* player = new Player(player_pos, 5.0, 10.0, 3.0, 100000.0, 100000.0);
-    delete [] player_pos;
-    grid[1][1]->setPlayer(player);
-    attachPlayerToKeys(grid, player);
+    Player* player = createPlayer(grid);
 
     // Boolean to tell the loop to stop
     bool stop = false;
 
+    // Physics steps at a fixed 120 Hz whatever the frame rate is, a frame can take at most 8 steps
+    SimulationClock clock(1.0 / 120.0, 8);
+
     // Input system initialized
     Input* input = new Input();
     double accel = 20;
@@ -117,63 +130,41 @@ int main (int argc, char** argv) {
         stop = true;
         input->stop();
     });
-    input->listenTo('w', [&accel, &player](double dt) -> void {
-        double vel = accel;
-        if (dt < 0.1) {
-            vel *= dt * dt;
-        } else {
-            vel *= 0.01;
-        }
-        std::vector<GameObject*> gos;
-        player->getChildrenOfType(Wheel::TYPE, &gos);
-        std::vector<GameObject*>::iterator it = gos.end();
-        it--;
-        Wheel* b_w = (Wheel*) (*it);
-        double * b_vel = b_w->getWheelVector();
-        douglas::vector::unitVector(b_vel);
-        douglas::vector::scale(b_vel, vel);
-        b_w->addVelocity(b_vel);
-        delete [] b_vel;
-
+    input->listenTo('w', [&accel, &player, &clock](double dt) -> void {
+        player->accelerate(accel, dt, clock.getStep());
     });
-    input->listenTo('s', [&accel, &player](double dt) -> void {
-        double vel = -1 * accel;
-        if (dt < 0.1) {
-            vel *= dt * dt;
-        } else {
-            vel *= 0.01;
-        }
-        std::vector<GameObject*> gos;
-        player->getChildrenOfType(Wheel::TYPE, &gos);
-        std::vector<GameObject*>::iterator it = gos.end();
-        it--;
-        Wheel* b_w = (Wheel*) (*it);
-        double * b_vel = b_w->getWheelVector();
-        douglas::vector::unitVector(b_vel);
-        douglas::vector::scale(b_vel, vel);
-        b_w->addVelocity(b_vel);
-        delete [] b_vel;
+    input->listenTo('s', [&accel, &player, &clock](double dt) -> void {
+        player->accelerate(-1 * accel, dt, clock.getStep());
     });
-    input->listenTo('d', [&accel, &angle, &player](double dt) -> void {
-        std::vector<GameObject*> gos;
-        player->getChildrenOfType(Wheel::TYPE, &gos);
-        std::vector<GameObject*>::iterator it = gos.begin();
-        ((Wheel*) (*it))->setAngle(angle);
+    input->listenTo('d', [&angle, &player](double dt) -> void {
+        player->steer(angle);
     });
-    input->listenTo('a', [&accel, &angle, &player](double dt) -> void {
-        std::vector<GameObject*> gos;
-        player->getChildrenOfType(Wheel::TYPE, &gos);
-        std::vector<GameObject*>::iterator it = gos.begin();
-        ((Wheel*) (*it))->setAngle(-1 * angle);
+    input->listenTo('a', [&angle, &player](double dt) -> void {
+        player->steer(-1 * angle);
     });
     input->listen();
 
-    // Create screen
-    Screen* screen = new Screen(screen_width, screen_height);
+    // Create screen, when recording the frames go to the terminal through the recorder
+    TerminalSink terminal;
+    RecorderSink* recorder = nullptr;
+    if(!record_path.empty()) {
+        recorder = new RecorderSink(record_path, &terminal);
+    }
+    Screen* screen = new Screen(screen_width, screen_height, recorder);
+
+    // Rooms share nothing while stepping, so they are stepped across a pool of threads
+    ThreadPool* pool = new ThreadPool();
 
     // Easy access to the middle room
     GridMM* gridMM = (GridMM*) grid[1][1];
 
+    // Timings of the last window of frames
+    FrameStats stats(120);
+    unsigned int step_series = stats.getSeries("Step");
+    unsigned int render_series = stats.getSeries("Render");
+    unsigned int write_series = stats.getSeries("Write");
+    unsigned int frame_series = stats.getSeries("Frame");
+
     double dt = 0.5;
     std::chrono::high_resolution_clock::time_point t = std::chrono::high_resolution_clock::now();
     std::chrono::high_resolution_clock::time_point start_time = t;
@@ -192,9 +183,7 @@ int main (int argc, char** argv) {
             input->getInput();
         }
 
-        gridMM->setMarker(1, checkKey(1, grid));
-        gridMM->setMarker(2, checkKey(2, grid));
-        gridMM->setMarker(3, checkKey(3, grid));
+        updateMarkers(grid);
 
         if(room == gridMM && gridMM->getMarker(1) && gridMM->getMarker(2) && gridMM->getMarker(3)) {
             if(!win_state) {
@@ -205,34 +194,55 @@ int main (int argc, char** argv) {
             win_state = true;
         }
 
-        // Step all the rooms
+        // Step all the rooms as many fixed steps as the frame took, the player can change rooms after any of them
         std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
-        stepRooms(grid, dt);
-        screen->printValue(1, " Step Time: " +
-                              std::to_string((std::chrono::high_resolution_clock::now() - t2).count() / 1000000000.0));
+        unsigned int substeps = clock.advance(dt);
+        for(unsigned int k = 0; k < substeps; k++) {
+            stepRooms(grid, clock.getStep(), pool);
+            room = getPlayerRoom(grid);
+            if(room != nullptr) {
+                room->checkPlayerLocation();
+            }
+        }
+        stats.add(step_series, (std::chrono::high_resolution_clock::now() - t2).count() / 1000000000.0);
+
+        // Draw the room the player ended up in, between its last two steps by how far the frame is into the next
+        room = getPlayerRoom(grid);
+        if(room == nullptr) {
+            std::cout << "ERROR: No room had the player in it." << std::endl;
+            break;
+        }
+        room->setRenderAlpha(clock.getAlpha());
 
         // Render all the elements
         t2 = std::chrono::high_resolution_clock::now();
-        room->render(screen);
-        screen->printValue(2, " Render Time: " +
-                std::to_string((std::chrono::high_resolution_clock::now() - t2).count() / 1000000000.0));
+        {
+            Trace::Scope trace("render", room->getType());
+            room->render(screen);
+        }
+        stats.add(render_series, (std::chrono::high_resolution_clock::now() - t2).count() / 1000000000.0);
 
         // Display onto terminal
         t2 = std::chrono::high_resolution_clock::now();
         screen->displayFrame();
-        screen->printValue(3, " Terminal Write Time: " +
-                              std::to_string((std::chrono::high_resolution_clock::now() - t2).count() / 1000000000.0));
-
-        // Print out stats
-        screen->printValue(0, " FPS: " + std::to_string(1/dt));
-        screen->printValue(5, " Room Type: " + room->getType());
+        stats.add(write_series, (std::chrono::high_resolution_clock::now() - t2).count() / 1000000000.0);
+
+        // Print out stats, percentiles over the last few seconds as single frames are too noisy to read
+        FrameStats::Summary frame = stats.summarize(frame_series);
+        screen->printValue(0, " FPS: " + std::to_string(frame.p50 > 0 ? 1 / frame.p50 : 0));
+        stats.printSummary(screen, 1, step_series);
+        stats.printSummary(screen, 2, render_series);
+        stats.printSummary(screen, 3, write_series);
+        stats.printSummary(screen, 4, frame_series);
+        screen->printValue(5, " Room Type: " + room->getTypeName());
         screen->printValue(7, " Time Left: " + std::to_string(time_limit - ((t - start_time).count() / 1000000000.0)));
-
-        room->checkPlayerLocation();
+        // Rows 9 to 18 belong to the rooms' render(), so the graph goes below them
+        stats.printGraph(screen, 20, frame_series, 40, 5);
 
         std::chrono::high_resolution_clock::time_point nt = std::chrono::high_resolution_clock::now();
         dt = (nt - t).count() / 1000000000.0;
         t = nt;
+        stats.add(frame_series, dt);
 
         if ((t - start_time).count() / 1000000000.0 > time_limit) {
             break;
@@ -242,16 +252,17 @@ int main (int argc, char** argv) {
     std::cout << std::endl << std::endl;
     printEnding(win_state);
 
+    if(!trace_path.empty()) {
+        Trace::setEnabled(false);
+        Trace::dump(trace_path);
+    }
+
     delete input;
+    delete pool;
     // clear all the memory of grid including the space pointers
-    for(int i = 0; i < 3; i++) {
-        for(int j = 0; j < 3; j++) {
-            delete grid[i][j];
-        }
-        delete [] grid[i];
-    }
-    delete [] grid;
+    deleteGrid(grid);
     delete screen;
+    delete recorder;
 
     return 0;
 
@@ -265,78 +276,3 @@ void printEnding(bool state) {
         std::cout << "Game Over." << std::endl;
     }
 }
-
-bool checkKey(int k_int, Room* **grid) {
-    switch (k_int) {
-        case 1: {
-            return ((GridLM*) grid[0][1])->getKey()->getPickedUp();
-        }
-        case 2: {
-            return ((GridLT*) grid[0][0])->getKey()->getPickedUp();
-        }
-        case 3: {
-            return ((GridRT*) grid[2][0])->getKey()->getPickedUp();
-        }
-    }
-    return false;
-}
-
-void attachPlayerToKeys(Room* **grid, Player* player) {
-    std::vector<GameObject*>::iterator it;
-    std::vector<GameObject*> particles;
-    player->getChildrenOfType(Particle::TYPE, &particles);
-    for(it = particles.begin(); it != particles.end(); it++) {
-        Particle* p = (Particle*) *it;
-        ((GridLM*) grid[0][1])->getKey()->getKeyConstraint()->addParticle(p);
-        ((GridLT*) grid[0][0])->getKey()->getKeyConstraint()->addParticle(p);
-        ((GridRT*) grid[2][0])->getKey()->getKeyConstraint()->addParticle(p);
-    }
-}
-
-void initializeGrid(Room* **grid, double w, double h) {
-    grid[0][0] = new GridLT(w, h);
-    grid[1][0] = new GridMT(w, h);
-    grid[2][0] = new GridRT(w, h);
-    grid[0][1] = new GridLM(w, h);
-    grid[1][1] = new GridMM(w, h);
-    grid[2][1] = new GridRM(w, h);
-    grid[0][2] = new GridLB(w, h);
-    grid[1][2] = new GridMB(w, h);
-    grid[2][2] = new GridRB(w, h);
-
-    for(int i = 0; i < 3; i++) {
-        for(int j = 0; j < 3; j++) {
-            if (i > 0) {
-                grid[i][j]->setSpace(3, grid[i - 1][j]);
-            }
-            if (i < 2) {
-                grid[i][j]->setSpace(1, grid[i + 1][j]);
-            }
-            if (j > 0) {
-                grid[i][j]->setSpace(0, grid[i][j - 1]);
-            }
-            if (j < 2) {
-                grid[i][j]->setSpace(2, grid[i][j + 1]);
-            }
-        }
-    }
-}
-
-Room* getPlayerRoom(Room* **grid) {
-    for(int i = 0; i < 3; i++) {
-        for(int j = 0; j < 3; j++) {
-            if (grid[i][j]->hasPlayer()) {
-                return grid[i][j];
-            }
-        }
-    }
-    return nullptr;
-}
-
-void stepRooms(Room* **grid, double dt) {
-    for(int i = 0; i < 3; i++) {
-        for(int j = 0; j < 3; j++) {
-            grid[i][j]->step(dt);
-        }
-    }
-}
\ No newline at end of file
@@ -8,10 +8,12 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 unsigned int GameObject::n_obj_id = 0;
-std::string GameObject::TYPE = "game_object";
+TypeId GameObject::TYPE = Typed::registerType("game_object");
+constexpr int GameObject::RENDER_STEPS;
 
 // GameObject Constructor
 GameObject::GameObject() : Typed(GameObject::TYPE) {
@@ -20,7 +22,7 @@ GameObject::GameObject() : Typed(GameObject::TYPE) {
 
 // GameObject Copy Constructor
 GameObject::GameObject(const GameObject &obj) : Typed(GameObject::TYPE) {
-    types.push_back(GameObject::TYPE);
+    addType(GameObject::TYPE);
     children = obj.children;
     obj_id = n_obj_id++;
 }
@@ -39,6 +41,13 @@ void GameObject::newChild(GameObject *child) {
     }
 }
 
+// Protected function called whenever a child is removed from GameObject or from under GameObject in GameObject tree
+void GameObject::removedChild(GameObject *child) {
+    if(parent != nullptr) {
+        parent->removedChild(child);
+    }
+}
+
 // Retrieve index of child based off of child id
 unsigned int GameObject::getChildIndex(unsigned int c_obj_id) {
 
@@ -77,7 +86,9 @@ void GameObject::removeChild(unsigned int c_obj_id) {
 
     try {
         int index = getChildIndex(c_obj_id);
+        GameObject* child = children[index];
         children.erase(children.begin() + index, children.begin() + index + 1);
+        removedChild(child);
     } catch ( std::exception e ) {
         std::cerr << e.what() << std::endl;
     }
@@ -94,7 +105,7 @@ GameObject* GameObject::getWorld() {
 }
 
 // Retrieve all parents of a specified type
-void GameObject::getParentsOfType(std::string type, std::vector<GameObject*>* vec) {
+void GameObject::getParentsOfType(TypeId type, std::vector<GameObject*>* vec) {
     if(this->isType(type)) {
         vec->push_back(this);
     }
@@ -104,7 +115,7 @@ void GameObject::getParentsOfType(std::string type, std::vector<GameObject*>* ve
 }
 
 // Retrieve all children of a specified type
-void GameObject::getChildrenOfType(std::string type, std::vector < GameObject * > * vec) {
+void GameObject::getChildrenOfType(TypeId type, std::vector < GameObject * > * vec) {
     if(this->isType(type)) {
         vec->push_back(this);
     }
@@ -117,7 +128,7 @@ void GameObject::getChildrenOfType(std::string type, std::vector < GameObject *
 }
 
 // Retrieve all immediate children of a specified type
-void GameObject::getImmediateChildrenOfType(std::string type, std::vector < GameObject * > * vec) {
+void GameObject::getImmediateChildrenOfType(TypeId type, std::vector < GameObject * > * vec) {
     if(children.size() > 0) {
         std::vector<GameObject*>::iterator it;
         for(it = children.begin(); it != children.end(); it++) {
@@ -138,25 +149,47 @@ void GameObject::stepChildren(double dt) {
 
 }
 
-// Render all the children to the screen
+// Render all the children to the screen, other than the ones already drawn into a background
 void GameObject::renderChildren(Screen *screen) {
 
     std::vector<GameObject*>::iterator it;
     for(it = children.begin(); it != children.end(); it++) {
-        (*it)->render(screen);
+        if(!(*it)->baked) {
+            (*it)->render(screen);
+        }
     }
 
 }
 
-// Step the GameObject along
-void GameObject::step(double dt) {
-
-    if(previous_dt < 0) {
-        previous_dt = dt;
+// Round render_points to the render key and compare it with the key rendered_pixels was drawn from.  Returns true,
+// and keeps the new key, when the object has to be drawn again.
+bool GameObject::renderKeyChanged() {
+    bool different = changed || render_key.size() != 2 * render_points.size();
+    render_key.resize(2 * render_points.size());
+    for(unsigned int i = 0; i < render_points.size(); i++) {
+        long x = std::lround(render_points[i].x * RENDER_STEPS);
+        long y = std::lround(render_points[i].y * RENDER_STEPS);
+        if(render_key[2 * i] != x || render_key[(2 * i) + 1] != y) {
+            render_key[2 * i] = x;
+            render_key[(2 * i) + 1] = y;
+            different = true;
+        }
     }
+    changed = false;
+    return different;
+}
+
+// Step the GameObject and everything under it along
+void GameObject::step(double dt) {
 
+    update(dt);
     stepChildren(dt);
 
+}
+
+// Step only this GameObject along, not its children
+void GameObject::update(double dt) {
+
     previous_dt = dt;
 
 }
\ No newline at end of file
@@ -22,19 +22,30 @@ protected:
     char draw_char = '#';
     bool changed = true;
     std::vector<Pixel> rendered_pixels;
+    // Pixel positions rendered_pixels was drawn from, each rounded to 1 / RENDER_STEPS of a pixel.  A render fills
+    // render_points and only draws again when renderKeyChanged says they moved to a different key.
+    std::vector<douglas::Vec2> render_points;
+    std::vector<long> render_key;
+    bool renderKeyChanged();
+    // Set once a Space has drawn the object into its background, after that the object is not rendered on its own
+    bool baked = false;
     GameObject* parent = nullptr;
     GameObject* world = nullptr;
     std::vector<GameObject*> children;
     unsigned int getChildIndex(unsigned int c_obj_id);
-    void stepChildren(double dt);
+    virtual void stepChildren(double dt);
     void renderChildren(Screen* screen);
 
     virtual void newChild(GameObject* child);
+    virtual void removedChild(GameObject* child);
 
 public:
 
     static unsigned int n_obj_id;
-    static std::string TYPE;
+    static TypeId TYPE;
+
+    // Fractions of a pixel that render keys are rounded to
+    constexpr static int RENDER_STEPS = 16;
 
     // Constructors
     GameObject();
@@ -58,23 +69,30 @@ public:
 
     // Recursive functions
     GameObject* getWorld();
-    void getParentsOfType(std::string, std::vector<GameObject*>*);
-    void getChildrenOfType(std::string, std::vector<GameObject*>*);
-    void getImmediateChildrenOfType(std::string, std::vector<GameObject*>*);
+    void getParentsOfType(TypeId, std::vector<GameObject*>*);
+    void getChildrenOfType(TypeId, std::vector<GameObject*>*);
+    void getImmediateChildrenOfType(TypeId, std::vector<GameObject*>*);
 
     // Time Step
     virtual void step(double dt);
+    virtual void update(double dt);
     double getPreviousStepTime() { return previous_dt; }
 
     // Draw char
     char getDrawChar() { return draw_char; }
     void setDrawChar(char c) { this->draw_char = c; }
 
-    // Pre-Rendered Section
+    // Pre-Rendered Section, setting changed makes the next render draw again even if the render key is the same
     bool getChanged() { return changed; }
     void setChanged(bool b) { this->changed = b; }
     const std::vector<Pixel> getRendered() { return rendered_pixels; }
 
+    // Objects that never move can be drawn once into the background of their Space by renderStatic
+    virtual bool isStatic() { return false; }
+    virtual void renderStatic(Screen* screen, std::vector<Pixel>* vec) {}
+    bool getBaked() { return baked; }
+    void setBaked(bool b) { this->baked = b; }
+
     // Virtual Render function
     virtual void render(Screen* screen) = 0;
 
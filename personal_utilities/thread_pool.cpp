@@ -0,0 +1,167 @@
+/**
+ * Author:          Brennan Douglas
+ * Date:            10/17/2026
+ * Description:     A fixed size, work stealing pool of worker threads.
+ *                  ThreadPool class source file.
+ */
+
+#include "thread_pool.hpp"
+
+thread_local ThreadPool* ThreadPool::current_pool = nullptr;
+thread_local unsigned int ThreadPool::current_queue = 0;
+
+// Default constructor, one worker for each hardware thread other than the one that creates the pool
+ThreadPool::ThreadPool() : ThreadPool(std::thread::hardware_concurrency() > 1 ?
+                                      std::thread::hardware_concurrency() - 1 : 1) {}
+
+// Constructor
+// <threads> is the number of worker threads to start
+ThreadPool::ThreadPool(unsigned int threads) : queued(0), stopping(false) {
+    for(unsigned int i = 0; i <= threads; i++) {
+        queues.push_back(new Queue());
+    }
+    for(unsigned int i = 0; i < threads; i++) {
+        workers.push_back(std::thread(&ThreadPool::work, this, i));
+    }
+}
+
+// Deconstructor, finishes every queued task before the workers are joined
+ThreadPool::~ThreadPool() {
+    stopping = true;
+    notifyAll();
+    for(unsigned int i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+    for(unsigned int i = 0; i < queues.size(); i++) {
+        delete queues[i];
+    }
+}
+
+// Queue that the current thread submits to
+unsigned int ThreadPool::homeQueue() {
+    return current_pool == this ? current_queue : queues.size() - 1;
+}
+
+// Wake every sleeping thread.  The sleep lock is taken first so a thread that just checked for work and is about to
+// sleep can not miss the wake up.
+void ThreadPool::notifyAll() {
+    {
+        std::lock_guard<std::mutex> guard(sleep_lock);
+    }
+    wake.notify_all();
+}
+
+// Queue a task to be run by the pool
+// <group> is the group the task belongs to, or nullptr for the pool's own group
+void ThreadPool::submit(std::function<void()> task, TaskGroup *group) {
+    if(group == nullptr) {
+        group = &default_group;
+    }
+    group->pending++;
+
+    // Counted before it is pushed so the count is never lower than the number of tasks in the queues
+    queued++;
+    Queue* q = queues[homeQueue()];
+    {
+        std::lock_guard<std::mutex> guard(q->lock);
+        Task t = { std::move(task), group };
+        q->tasks.push_back(std::move(t));
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(sleep_lock);
+    }
+    wake.notify_one();
+}
+
+// Take a task to run, the newest one from the <home> queue or else the oldest one from any other queue
+bool ThreadPool::pop(unsigned int home, Task &task) {
+    if(queued == 0) {
+        return false;
+    }
+    for(unsigned int i = 0; i < queues.size(); i++) {
+        Queue* q = queues[(home + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(q->lock);
+        if(q->tasks.empty()) {
+            continue;
+        }
+        if(i == 0) {
+            task = std::move(q->tasks.back());
+            q->tasks.pop_back();
+        } else {
+            task = std::move(q->tasks.front());
+            q->tasks.pop_front();
+        }
+        queued--;
+        return true;
+    }
+    return false;
+}
+
+// Run a single task, recording the first exception of its group, and mark it done
+void ThreadPool::execute(Task &task) {
+    try {
+        task.run();
+    } catch (...) {
+        std::lock_guard<std::mutex> guard(task.group->lock);
+        if(!task.group->error) {
+            task.group->error = std::current_exception();
+        }
+    }
+    if(--task.group->pending == 0) {
+        notifyAll();
+    }
+}
+
+// Block until every task in <group> has finished, running queued tasks on this thread in the mean time
+// <group> is the group to wait on, or nullptr for the pool's own group
+void ThreadPool::wait(TaskGroup *group) {
+    if(group == nullptr) {
+        group = &default_group;
+    }
+    unsigned int home = homeQueue();
+    while(group->pending > 0) {
+        Task task;
+        if(pop(home, task)) {
+            execute(task);
+        } else {
+            std::unique_lock<std::mutex> guard(sleep_lock);
+            wake.wait(guard, [this, group]() { return group->pending == 0 || queued > 0; });
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(group->lock);
+    if(group->error) {
+        std::exception_ptr e = group->error;
+        group->error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+// Run <body> for every index from 0 to <n> - 1 across the pool, and wait for all of them to finish
+void ThreadPool::parallelFor(unsigned int n, const std::function<void(unsigned int)> &body) {
+    TaskGroup group;
+    for(unsigned int i = 0; i < n; i++) {
+        submit([&body, i]() { body(i); }, &group);
+    }
+    wait(&group);
+}
+
+// Worker thread loop
+// <index> is the worker's own queue
+void ThreadPool::work(unsigned int index) {
+    current_pool = this;
+    current_queue = index;
+    while(true) {
+        Task task;
+        if(pop(index, task)) {
+            execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(sleep_lock);
+        wake.wait(guard, [this]() { return stopping || queued > 0; });
+        if(stopping && queued == 0) {
+            return;
+        }
+    }
+}
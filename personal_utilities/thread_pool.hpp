@@ -0,0 +1,79 @@
+/**
+ * Author:          Brennan Douglas
+ * Date:            10/17/2026
+ * Description:     A fixed size, work stealing pool of worker threads.
+ *                  ThreadPool class header file.
+ */
+
+#ifndef DOUGLBRE_PERSONAL_UTILITES_THREAD_POOL_HPP
+#define DOUGLBRE_PERSONAL_UTILITES_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// This class keeps a set of worker threads alive that run submitted tasks.  Every worker has its own queue, it takes
+// its newest task first and when it runs out it steals the oldest task from another queue.  Threads outside the pool
+// submit to one shared queue.  Tasks can be put in a TaskGroup and wait() only waits for that group, so a task can
+// submit and wait on more tasks without blocking the pool.  The thread that waits helps run tasks instead of sleeping.
+// If a task throws the first exception in its group is handed back to the caller of wait().
+class ThreadPool {
+public:
+    // Tasks that are waited on together
+    class TaskGroup {
+        friend class ThreadPool;
+        std::atomic<unsigned int> pending;
+        std::mutex lock;
+        std::exception_ptr error;
+    public:
+        TaskGroup() : pending(0) {}
+    };
+
+private:
+    struct Task {
+        std::function<void()> run;
+        TaskGroup* group;
+    };
+
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<Queue*> queues;             // One for each worker, the last one is shared by outside threads
+    std::atomic<unsigned int> queued;
+    std::atomic<bool> stopping;
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+    TaskGroup default_group;
+
+    // Which pool and queue the current thread works for
+    static thread_local ThreadPool* current_pool;
+    static thread_local unsigned int current_queue;
+
+    unsigned int homeQueue();
+    bool pop(unsigned int home, Task &task);
+    void execute(Task &task);
+    void work(unsigned int index);
+    void notifyAll();
+public:
+    ThreadPool();
+    ThreadPool(unsigned int threads);
+    ThreadPool(const ThreadPool &obj) = delete;
+    ThreadPool &operator =(const ThreadPool &obj) = delete;
+    ~ThreadPool();
+
+    unsigned int size() { return workers.size(); }
+
+    void submit(std::function<void()> task, TaskGroup* group = nullptr);
+    void wait(TaskGroup* group = nullptr);
+    void parallelFor(unsigned int n, const std::function<void(unsigned int)> &body);
+};
+
+#endif //DOUGLBRE_PERSONAL_UTILITES_THREAD_POOL_HPP
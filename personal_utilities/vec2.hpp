@@ -0,0 +1,102 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the header file for the Vec2 value type
+ */
+
+#ifndef FINAL_PROJECT_VEC2_HPP
+#define FINAL_PROJECT_VEC2_HPP
+
+#include <cmath>
+
+namespace douglas {
+
+    // A 2-d vector that is passed around by value, so none of the vector math needs the heap.
+    struct Vec2 {
+        double x;
+        double y;
+
+        constexpr Vec2() : x(0), y(0) {}
+        constexpr Vec2(double x, double y) : x(x), y(y) {}
+        // Build from a 2-d array
+        constexpr explicit Vec2(const double * v) : x(v[0]), y(v[1]) {}
+
+        constexpr Vec2 operator +(const Vec2 &v) const { return Vec2(x + v.x, y + v.y); }
+        constexpr Vec2 operator -(const Vec2 &v) const { return Vec2(x - v.x, y - v.y); }
+        constexpr Vec2 operator -() const { return Vec2(-x, -y); }
+        constexpr Vec2 operator *(const double c) const { return Vec2(x * c, y * c); }
+        constexpr Vec2 operator /(const double c) const { return Vec2(x / c, y / c); }
+
+        Vec2 &operator +=(const Vec2 &v) { x += v.x; y += v.y; return *this; }
+        Vec2 &operator -=(const Vec2 &v) { x -= v.x; y -= v.y; return *this; }
+        Vec2 &operator *=(const double c) { x *= c; y *= c; return *this; }
+
+        constexpr bool operator ==(const Vec2 &v) const { return x == v.x && y == v.y; }
+        constexpr bool operator !=(const Vec2 &v) const { return !(*this == v); }
+
+        constexpr double dot(const Vec2 &v) const { return (x * v.x) + (y * v.y); }
+        // Magnitude of the cross product, the z component if both vectors were in the x-y plane
+        constexpr double cross(const Vec2 &v) const { return (x * v.y) - (y * v.x); }
+        constexpr double magnitudeSquared() const { return dot(*this); }
+        double magnitude() const { return std::sqrt(magnitudeSquared()); }
+        double distance(const Vec2 &v) const { return (v - *this).magnitude(); }
+
+        // Vector rotated 90 degrees counter clockwise
+        constexpr Vec2 orthogonal() const { return Vec2(-y, x); }
+        // Projection of this vector onto <onto>
+        constexpr Vec2 project(const Vec2 &onto) const { return onto * (dot(onto) / onto.dot(onto)); }
+        Vec2 unit() const { return *this / magnitude(); }
+    };
+
+    constexpr Vec2 operator *(const double c, const Vec2 &v) { return v * c; }
+
+    // Result of a line segment intersection, evaluates to false when the segments do not cross
+    struct Intersection {
+        bool hit;
+        Vec2 point;
+
+        constexpr Intersection() : hit(false), point() {}
+        constexpr explicit Intersection(const Vec2 &point) : hit(true), point(point) {}
+
+        explicit operator bool() const { return hit; }
+    };
+
+    // Parametric result of a line segment test, <t> is how far along the first segment and <u> how far along the second
+    // segment the crossing is.  Both are 0 when there is no hit.
+    struct SegmentHit {
+        bool hit;
+        double t;
+        double u;
+    };
+
+    // Test if the line segment <l1_p1> to <l1_p2> crosses the line segment <l2_p1> to <l2_p2>.  The divide is done once
+    // at the end and the range checks are combined without short circuiting, so a miss costs no more than a hit.
+    inline SegmentHit segmentHit(const Vec2 &l1_p1, const Vec2 &l1_p2, const Vec2 &l2_p1, const Vec2 &l2_p2) {
+        Vec2 r = l1_p2 - l1_p1;
+        Vec2 s = l2_p2 - l2_p1;
+        Vec2 q = l2_p1 - l1_p1;
+        double denominator = r.cross(s);
+        // Flip everything to a positive denominator so the range checks do not need a division
+        double sign = std::copysign(1.0, denominator);
+        double d = denominator * sign;
+        double t_n = q.cross(s) * sign;
+        double u_n = q.cross(r) * sign;
+        // Parallel lines have a zero denominator and never meet
+        bool hit = (d != 0) & (t_n >= 0) & (t_n <= d) & (u_n >= 0) & (u_n <= d);
+        double inverse = hit ? 1.0 / d : 0;
+        SegmentHit out = { hit, t_n * inverse, u_n * inverse };
+        return out;
+    }
+
+    // Find where the line segment <l1_p1> to <l1_p2> crosses the line segment <l2_p1> to <l2_p2>
+    inline Intersection intersection(const Vec2 &l1_p1, const Vec2 &l1_p2, const Vec2 &l2_p1, const Vec2 &l2_p2) {
+        SegmentHit h = segmentHit(l1_p1, l1_p2, l2_p1, l2_p2);
+        if (!h.hit) {
+            return Intersection();
+        }
+        return Intersection(l1_p1 + ((l1_p2 - l1_p1) * h.t));
+    }
+
+}
+
+#endif //FINAL_PROJECT_VEC2_HPP
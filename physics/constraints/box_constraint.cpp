@@ -5,7 +5,7 @@
 #include "box_constraint.hpp"
 #include <string>
 
-std::string BoxConstraint::TYPE = "box_constraint";
+TypeId BoxConstraint::TYPE = Typed::registerType("box_constraint");
 
 // Default constructor for the BoxConstraint
 // <x> is the bottom left x-cord of the constraint
@@ -20,7 +20,7 @@ protected:
     double rigid;
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     BoxConstraint(double x, double y, double width, double height, double rigid);
     BoxConstraint(int* pos, double width, double height, double rigid);
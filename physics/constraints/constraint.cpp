@@ -7,7 +7,7 @@
 #include "constraint.hpp"
 #include <string>
 
-std::string Constraint::TYPE = "constraint";
+TypeId Constraint::TYPE = Typed::registerType("constraint");
 
 // Remove a particle from the list of particles effected
 void Constraint::removeParticle(unsigned int id) {
@@ -22,7 +22,7 @@ public:
 
     enum Equality { EQUAL, LESS_THAN, LESS_THAN_EQUAL, GREATER_THAN, GREATER_THAN_EQUAL};
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     Constraint() : Typed(Constraint::TYPE) {}
     virtual ~Constraint() {}
@@ -8,7 +8,7 @@
 #include <string>
 #include <cmath>
 
-std::string DragConstraint::TYPE = "drag_constraint";
+TypeId DragConstraint::TYPE = Typed::registerType("drag_constraint");
 
 // Constructor for DragConstraint
 // <drag> is the coefficient multiplied by the square of the velocity to determine how much the particle will be
@@ -24,9 +24,9 @@ void DragConstraint::fix(int iter, Particle *p) {
         return;
     }
     double p_dt = p->getPreviousStepTime();
-    const double * ppos = p->getPPosition();
-    double v_x = ((*p)[0] - ppos[0]) / p_dt;
-    double v_y = ((*p)[1] - ppos[1]) / p_dt;
+    douglas::Vec2 ppos = p->getPPosition();
+    double v_x = ((*p)[0] - ppos.x) / p_dt;
+    double v_y = ((*p)[1] - ppos.y) / p_dt;
     if (std::abs(v_x) < 0.00001) {
         return;
     } else if (std::abs(v_y) < 0.00001) {
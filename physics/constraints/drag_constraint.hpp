@@ -17,7 +17,7 @@ private:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     DragConstraint(double);
 
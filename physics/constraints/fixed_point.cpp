@@ -5,20 +5,20 @@
  */
 
 #include "fixed_point.hpp"
-#include "../../personal_utilities/vec_func.hpp"
 
-std::string FixedPoint::TYPE = "fixed_point";
+TypeId FixedPoint::TYPE = Typed::registerType("fixed_point");
 
 // Constructor for FixedPoint class
 // <point> vector of the point that all effected particles will be held at
 FixedPoint::FixedPoint(double *point) : SingleConstraint() {
     addType(FixedPoint::TYPE);
-    this->point = douglas::vector::copy(point);
+    this->point = douglas::Vec2(point);
 }
 
-// Deconstructor for FixedPoint to delete point vector
-FixedPoint::~FixedPoint() {
-    delete [] point;
+// Same as above with the point given as a Vec2
+FixedPoint::FixedPoint(const douglas::Vec2 &point) : SingleConstraint() {
+    addType(FixedPoint::TYPE);
+    this->point = point;
 }
 
 // Method that sets the position of the particle to the specified point
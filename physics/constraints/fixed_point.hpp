@@ -8,15 +8,16 @@
 #define FINAL_PROJECT_FIXED_POINT_HPP
 
 #include "single_constraint.hpp"
+#include "../../personal_utilities/vec2.hpp"
 
 // The fixed point class keeps all effected particles at a specific point
 class FixedPoint : public SingleConstraint {
 protected:
-    double * point;
+    douglas::Vec2 point;
 public:
-    static std::string TYPE;
+    static TypeId TYPE;
     FixedPoint(double * point);
-    ~FixedPoint();
+    FixedPoint(const douglas::Vec2 &point);
     void fix(int iter, Particle* particle);
 };
 
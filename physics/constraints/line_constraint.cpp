@@ -8,7 +8,8 @@
 #include <stdexcept>
 #include <string>
 
-std::string LineConstraint::TYPE = "line_constraint";
+TypeId LineConstraint::TYPE = Typed::registerType("line_constraint");
+std::atomic<unsigned long> LineConstraint::generation(0);
 
 // LineConstraint constructor
 // <length> is the length at which the particles will be help to the equality
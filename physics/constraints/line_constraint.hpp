@@ -8,6 +8,7 @@
 #define FINAL_PROJECT_LINE_CONSTRAINT_HPP
 
 #include "pair_constraint.hpp"
+#include <atomic>
 #include <string>
 #include <cmath>
 
@@ -16,16 +17,20 @@ class LineConstraint : public PairConstraint {
 private:
     double length;
     Constraint::Equality  eq;
+
+    // Bumped whenever any LineConstraint's length or equality is changed, so copies of them know to update
+    static std::atomic<unsigned long> generation;
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     LineConstraint(double, Constraint::Equality);
 
     double getLength() { return length; }
-    void setLength(double length) { this->length = length; }
+    void setLength(double length) { this->length = length; generation++; }
     Constraint::Equality getEquality() { return eq; }
-    void setEquality(Constraint::Equality eq) { this->eq = eq; }
+    void setEquality(Constraint::Equality eq) { this->eq = eq; generation++; }
+    static unsigned long getGeneration() { return generation; }
 
     void fix(int, Particle*, Particle*);
 };
@@ -8,7 +8,7 @@
 #include <string>
 #include <stdexcept>
 
-std::string PairConstraint::TYPE = "pair_constraint";
+TypeId PairConstraint::TYPE = Typed::registerType("pair_constraint");
 
 // Basic constructor for PairConstraint
 PairConstraint::PairConstraint() : Constraint() {
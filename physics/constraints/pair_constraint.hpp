@@ -14,7 +14,7 @@
 class PairConstraint : public Constraint {
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     PairConstraint();
 
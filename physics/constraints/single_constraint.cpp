@@ -7,7 +7,7 @@
 #include "single_constraint.hpp"
 #include <string>
 
-std::string SingleConstraint::TYPE = "single_constraint";
+TypeId SingleConstraint::TYPE = Typed::registerType("single_constraint");
 
 // Basic constructor for SingleConstraint
 SingleConstraint::SingleConstraint() : Constraint() {
@@ -21,4 +21,11 @@ void SingleConstraint::fix(int iter) {
             fix(iter, particles[i]);
         }
     }
-}
\ No newline at end of file
+}
+
+// Applies the constraint to every particle in <particles>, constraints that can test many particles at once override this
+void SingleConstraint::fixAll(int iter, const std::vector<Particle*>& particles) {
+    for(unsigned int i = 0; i < particles.size(); i++) {
+        fix(iter, particles[i]);
+    }
+}
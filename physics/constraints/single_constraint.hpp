@@ -8,7 +8,9 @@
 #define FINAL_PROJECT_SINGLE_CONSTRAINT_HPP
 
 #include "constraint.hpp"
+#include "../../personal_utilities/vec2.hpp"
 #include <string>
+#include <vector>
 
 // Defines a constraint that can work on a single particle
 class SingleConstraint : public Constraint {
@@ -16,10 +18,15 @@ public:
 
     SingleConstraint();
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     void fix(int);
     virtual void fix(int, Particle*) = 0;
+    virtual void fixAll(int iter, const std::vector<Particle*>& particles);
+
+    // Box that the constraint can affect particles in, only for constraints that do not move during a step.
+    // Returns false when the constraint has no bounds and must see every particle.
+    virtual bool getBounds(douglas::Vec2* min, douglas::Vec2* max) { return false; }
 };
 
 #endif //FINAL_PROJECT_SINGLE_CONSTRAINT_HPP
@@ -5,11 +5,10 @@
  */
 
 #include "trapped_point.hpp"
-#include "../../personal_utilities/vec_func.hpp"
 #include "fixed_point.hpp"
 #include "../particle_container.hpp"
 
-std::string TrappedPoint::TYPE = "trapped_point";
+TypeId TrappedPoint::TYPE = Typed::registerType("trapped_point");
 
 // Constructor for TrappedPoint
 // <radius> minimum distance a particle has to be to become fixed
@@ -17,12 +16,7 @@ std::string TrappedPoint::TYPE = "trapped_point";
 TrappedPoint::TrappedPoint(double radius, double *point) : SingleConstraint() {
     addType(TrappedPoint::TYPE);
     this->radius = radius;
-    this->point = douglas::vector::copy(point);
-}
-
-// TrappedPoint deconstructor
-TrappedPoint::~TrappedPoint() {
-    delete [] this->point;
+    this->point = douglas::Vec2(point);
 }
 
 // Get particle index in toggles vector
@@ -37,7 +31,7 @@ int TrappedPoint::togglesGetParticleId(Particle *particle) {
 
 // Checks distance between point and particle then applies fixed point if possible
 void TrappedPoint::fix(int iter, Particle *p) {
-    double dist = douglas::vector::distance(p->getPosition(), this->point);
+    double dist = p->getPosition().distance(this->point);
     if (dist < radius) {
         int index = -1;
         if((index = togglesGetParticleId(p)) > -1) {
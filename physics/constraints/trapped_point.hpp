@@ -8,6 +8,7 @@
 #define FINAL_PROJECT_TRAPPED_POINT_HPP
 
 #include "single_constraint.hpp"
+#include "../../personal_utilities/vec2.hpp"
 
 // Defines a constraint where when a specified particle comes within a specified distance it will become fixed to it.
 class TrappedPoint : public SingleConstraint {
@@ -16,14 +17,13 @@ class TrappedPoint : public SingleConstraint {
         bool trapped;
     };
 protected:
-    double * point;
+    douglas::Vec2 point;
     double radius;
     std::vector<particle_toggle> toggles;
     int togglesGetParticleId(Particle* particle);
 public:
-    static std::string TYPE;
+    static TypeId TYPE;
     TrappedPoint(double radius, double * point);
-    ~TrappedPoint();
     void fix(int iter, Particle* p);
 };
 
@@ -0,0 +1,345 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the source file for the LineBatch class
+ */
+
+#include "line_batch.hpp"
+#include <algorithm>
+#include <cmath>
+
+constexpr unsigned int LineBatch::PARALLEL_PAIRS;
+
+// The SIMD kernels are only built for x86 compilers that can target a single function at AVX2, everywhere else the
+// scalar kernel is used
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define FINAL_PROJECT_LINE_BATCH_X86
+#include <immintrin.h>
+#endif
+
+// Solve pairs <begin> to <end> - 1 one at a time, the same arithmetic as LineConstraint::fix
+static void solveScalar(double* pos, const int* a, const int* b, const double* length, const double* scale_a,
+                        const double* scale_b, unsigned int begin, unsigned int end) {
+    for(unsigned int k = begin; k < end; k++) {
+        double* p1 = &pos[2 * a[k]];
+        double* p2 = &pos[2 * b[k]];
+        double dx = p2[0] - p1[0];
+        double dy = p2[1] - p1[1];
+        double dlength = std::sqrt((dx * dx) + (dy * dy));
+        if(dlength == length[k]) {
+            continue;
+        }
+        double diff = (dlength - length[k]) / dlength;
+        p1[0] += dx * scale_a[k] * diff;
+        p1[1] += dy * scale_a[k] * diff;
+        p2[0] -= dx * scale_b[k] * diff;
+        p2[1] -= dy * scale_b[k] * diff;
+    }
+}
+
+#ifdef FINAL_PROJECT_LINE_BATCH_X86
+
+// Solve pairs two at a time, each lane of a register is one pair.  Positions are stored as x, y pairs, so the two
+// particles on each side are loaded whole and shuffled into an x register and a y register.
+static void solveSSE2(double* pos, const int* a, const int* b, const double* length, const double* scale_a,
+                      const double* scale_b, unsigned int begin, unsigned int end) {
+    unsigned int k = begin;
+    for(; k + 2 <= end; k += 2) {
+        double* pa0 = &pos[2 * a[k]];
+        double* pa1 = &pos[2 * a[k + 1]];
+        double* pb0 = &pos[2 * b[k]];
+        double* pb1 = &pos[2 * b[k + 1]];
+        __m128d a0 = _mm_loadu_pd(pa0);
+        __m128d a1 = _mm_loadu_pd(pa1);
+        __m128d b0 = _mm_loadu_pd(pb0);
+        __m128d b1 = _mm_loadu_pd(pb1);
+        __m128d ax = _mm_unpacklo_pd(a0, a1);
+        __m128d ay = _mm_unpackhi_pd(a0, a1);
+        __m128d bx = _mm_unpacklo_pd(b0, b1);
+        __m128d by = _mm_unpackhi_pd(b0, b1);
+
+        __m128d dx = _mm_sub_pd(bx, ax);
+        __m128d dy = _mm_sub_pd(by, ay);
+        __m128d dlength = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+        __m128d len = _mm_loadu_pd(&length[k]);
+        // Pairs already at their length are left where they are
+        __m128d diff = _mm_and_pd(_mm_div_pd(_mm_sub_pd(dlength, len), dlength), _mm_cmpneq_pd(dlength, len));
+
+        __m128d sa = _mm_loadu_pd(&scale_a[k]);
+        __m128d sb = _mm_loadu_pd(&scale_b[k]);
+        ax = _mm_add_pd(ax, _mm_mul_pd(_mm_mul_pd(dx, sa), diff));
+        ay = _mm_add_pd(ay, _mm_mul_pd(_mm_mul_pd(dy, sa), diff));
+        bx = _mm_sub_pd(bx, _mm_mul_pd(_mm_mul_pd(dx, sb), diff));
+        by = _mm_sub_pd(by, _mm_mul_pd(_mm_mul_pd(dy, sb), diff));
+
+        _mm_storeu_pd(pa0, _mm_unpacklo_pd(ax, ay));
+        _mm_storeu_pd(pa1, _mm_unpackhi_pd(ax, ay));
+        _mm_storeu_pd(pb0, _mm_unpacklo_pd(bx, by));
+        _mm_storeu_pd(pb1, _mm_unpackhi_pd(bx, by));
+    }
+    solveScalar(pos, a, b, length, scale_a, scale_b, k, end);
+}
+
+// Solve pairs four at a time.  The x and y of each side are gathered straight out of the store, there is no scatter
+// so the results are shuffled back into x, y pairs and written out a particle at a time.  Only built for AVX2, and
+// not FMA, so every lane rounds the same way as the scalar kernel.
+__attribute__((target("avx2")))
+static void solveAVX2(double* pos, const int* a, const int* b, const double* length, const double* scale_a,
+                      const double* scale_b, unsigned int begin, unsigned int end) {
+    // The masked gather with every lane on is used because the plain one starts from an undefined register, which
+    // optimized builds warn about
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    unsigned int k = begin;
+    for(; k + 4 <= end; k += 4) {
+        __m128i ia = _mm_slli_epi32(_mm_loadu_si128((const __m128i*) &a[k]), 1);
+        __m128i ib = _mm_slli_epi32(_mm_loadu_si128((const __m128i*) &b[k]), 1);
+        __m256d ax = _mm256_mask_i32gather_pd(zero, pos, ia, all, 8);
+        __m256d ay = _mm256_mask_i32gather_pd(zero, pos + 1, ia, all, 8);
+        __m256d bx = _mm256_mask_i32gather_pd(zero, pos, ib, all, 8);
+        __m256d by = _mm256_mask_i32gather_pd(zero, pos + 1, ib, all, 8);
+
+        __m256d dx = _mm256_sub_pd(bx, ax);
+        __m256d dy = _mm256_sub_pd(by, ay);
+        __m256d dlength = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+        __m256d len = _mm256_loadu_pd(&length[k]);
+        // Pairs already at their length are left where they are
+        __m256d diff = _mm256_and_pd(_mm256_div_pd(_mm256_sub_pd(dlength, len), dlength),
+                                     _mm256_cmp_pd(dlength, len, _CMP_NEQ_UQ));
+
+        __m256d sa = _mm256_loadu_pd(&scale_a[k]);
+        __m256d sb = _mm256_loadu_pd(&scale_b[k]);
+        ax = _mm256_add_pd(ax, _mm256_mul_pd(_mm256_mul_pd(dx, sa), diff));
+        ay = _mm256_add_pd(ay, _mm256_mul_pd(_mm256_mul_pd(dy, sa), diff));
+        bx = _mm256_sub_pd(bx, _mm256_mul_pd(_mm256_mul_pd(dx, sb), diff));
+        by = _mm256_sub_pd(by, _mm256_mul_pd(_mm256_mul_pd(dy, sb), diff));
+
+        // Lanes 0 and 2 come out of unpacklo, 1 and 3 out of unpackhi
+        __m256d a02 = _mm256_unpacklo_pd(ax, ay);
+        __m256d a13 = _mm256_unpackhi_pd(ax, ay);
+        __m256d b02 = _mm256_unpacklo_pd(bx, by);
+        __m256d b13 = _mm256_unpackhi_pd(bx, by);
+        _mm_storeu_pd(&pos[2 * a[k]], _mm256_castpd256_pd128(a02));
+        _mm_storeu_pd(&pos[2 * a[k + 1]], _mm256_castpd256_pd128(a13));
+        _mm_storeu_pd(&pos[2 * a[k + 2]], _mm256_extractf128_pd(a02, 1));
+        _mm_storeu_pd(&pos[2 * a[k + 3]], _mm256_extractf128_pd(a13, 1));
+        _mm_storeu_pd(&pos[2 * b[k]], _mm256_castpd256_pd128(b02));
+        _mm_storeu_pd(&pos[2 * b[k + 1]], _mm256_castpd256_pd128(b13));
+        _mm_storeu_pd(&pos[2 * b[k + 2]], _mm256_extractf128_pd(b02, 1));
+        _mm_storeu_pd(&pos[2 * b[k + 3]], _mm256_extractf128_pd(b13, 1));
+    }
+    solveScalar(pos, a, b, length, scale_a, scale_b, k, end);
+}
+
+#endif
+
+// Whether <c> can be put in a batch for <store>, it has to be an EQUAL LineConstraint made of whole pairs of
+// particles that all live in <store>
+bool LineBatch::canBatch(Constraint *c, ParticleStore *store) {
+    if(!c->isType(LineConstraint::TYPE) || ((LineConstraint*) c)->getEquality() != Constraint::EQUAL) {
+        return false;
+    }
+    std::vector<Particle*> particles = c->getParticles();
+    if(particles.empty() || particles.size() % 2 != 0) {
+        return false;
+    }
+    for(unsigned int i = 0; i < particles.size(); i++) {
+        if(particles[i] == nullptr || particles[i]->getStore() != store) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether the processor, and the build, can run kernel <k>
+bool LineBatch::supported(Kernel k) {
+    switch (k) {
+        case AUTO:
+        case SCALAR:
+            return true;
+#ifdef FINAL_PROJECT_LINE_BATCH_X86
+        case SSE2:
+            return true;
+        case AVX2: {
+            static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+            return avx2;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+// The kernel AUTO runs, the widest one that can be run in an optimized build.  Without optimization the intrinsics are
+// not inlined and every lane goes through memory, which makes the SIMD kernels slower than the scalar one, so the
+// makefile's -O0 build always gets SCALAR.
+LineBatch::Kernel LineBatch::best() {
+#ifdef __OPTIMIZE__
+    if(supported(AVX2)) {
+        return AVX2;
+    } else if(supported(SSE2)) {
+        return SSE2;
+    }
+#endif
+    return SCALAR;
+}
+
+// Name of kernel <k>
+const char* LineBatch::kernelName(Kernel k) {
+    switch (k) {
+        case AUTO:
+            return "auto";
+        case SCALAR:
+            return "scalar";
+        case SSE2:
+            return "sse2";
+        case AVX2:
+            return "avx2";
+    }
+    return "unknown";
+}
+
+// Pack the pairs of <lines> and color them.  Each pair takes the first color that neither of its particles has been
+// given yet, and the pairs are then laid out color by color, keeping their order within a color.
+// <lines> must all pass canBatch for <store>
+void LineBatch::build(const std::vector<LineConstraint *> &lines, ParticleStore *store) {
+    clear();
+    this->store = store;
+
+    std::vector<int> pair_a;
+    std::vector<int> pair_b;
+    std::vector<LineConstraint*> pair_owner;
+    std::vector<unsigned int> pair_color;
+    std::vector<std::vector<bool>> taken;
+    for(unsigned int i = 0; i < lines.size(); i++) {
+        std::vector<Particle*> particles = lines[i]->getParticles();
+        for(unsigned int j = 0; j + 1 < particles.size(); j += 2) {
+            unsigned int p1 = particles[j]->getIndex();
+            unsigned int p2 = particles[j + 1]->getIndex();
+            unsigned int color = 0;
+            while(color < taken.size() && (taken[color][p1] || taken[color][p2])) {
+                color++;
+            }
+            if(color == taken.size()) {
+                taken.push_back(std::vector<bool>(store->size(), false));
+            }
+            taken[color][p1] = true;
+            taken[color][p2] = true;
+            pair_a.push_back(p1);
+            pair_b.push_back(p2);
+            pair_owner.push_back(lines[i]);
+            pair_color.push_back(color);
+        }
+    }
+
+    // Counting sort by color
+    colors.assign(taken.size() + 1, 0);
+    for(unsigned int k = 0; k < pair_color.size(); k++) {
+        colors[pair_color[k] + 1]++;
+    }
+    for(unsigned int c = 1; c < colors.size(); c++) {
+        colors[c] += colors[c - 1];
+    }
+    std::vector<unsigned int> next(colors.begin(), colors.end() - 1);
+    a.resize(pair_a.size());
+    b.resize(pair_a.size());
+    owners.resize(pair_a.size());
+    for(unsigned int k = 0; k < pair_a.size(); k++) {
+        unsigned int slot = next[pair_color[k]]++;
+        a[slot] = pair_a[k];
+        b[slot] = pair_b[k];
+        owners[slot] = pair_owner[k];
+    }
+
+    length.resize(a.size());
+    for(unsigned int k = 0; k < a.size(); k++) {
+        length[k] = owners[k]->getLength();
+    }
+    length_generation = LineConstraint::getGeneration();
+    updateWeights();
+}
+
+// Empty the batch
+void LineBatch::clear() {
+    store = nullptr;
+    a.clear();
+    b.clear();
+    length.clear();
+    scale_a.clear();
+    scale_b.clear();
+    owners.clear();
+    colors.clear();
+}
+
+// Work out how much of each correction each particle takes from their masses, the same way LineConstraint::fix does
+void LineBatch::updateWeights() {
+    scale_a.resize(a.size());
+    scale_b.resize(a.size());
+    for(unsigned int k = 0; k < a.size(); k++) {
+        double mass_ratio = store->getMass(a[k]) / store->getMass(b[k]);
+        scale_a[k] = 1 / (1 + mass_ratio);
+        scale_b[k] = scale_a[k] * mass_ratio;
+    }
+    mass_generation = store->getMassGeneration();
+}
+
+// Pick up lengths and masses that were changed since the batch was built.  Returns false when a constraint is no
+// longer EQUAL, then the batch has to be built again.
+bool LineBatch::refresh() {
+    if(store == nullptr) {
+        return true;
+    }
+    if(length_generation != LineConstraint::getGeneration()) {
+        length_generation = LineConstraint::getGeneration();
+        for(unsigned int k = 0; k < owners.size(); k++) {
+            if(owners[k]->getEquality() != Constraint::EQUAL) {
+                return false;
+            }
+            length[k] = owners[k]->getLength();
+        }
+    }
+    if(mass_generation != store->getMassGeneration()) {
+        updateWeights();
+    }
+    return true;
+}
+
+// Solve pairs <begin> to <end> - 1 with kernel <k>
+void LineBatch::solveRange(Kernel k, unsigned int begin, unsigned int end) {
+    double* pos = store->positions();
+    switch (k) {
+#ifdef FINAL_PROJECT_LINE_BATCH_X86
+        case AVX2:
+            solveAVX2(pos, a.data(), b.data(), length.data(), scale_a.data(), scale_b.data(), begin, end);
+            break;
+        case SSE2:
+            solveSSE2(pos, a.data(), b.data(), length.data(), scale_a.data(), scale_b.data(), begin, end);
+            break;
+#endif
+        default:
+            solveScalar(pos, a.data(), b.data(), length.data(), scale_a.data(), scale_b.data(), begin, end);
+            break;
+    }
+}
+
+// Solve every pair once, a color at a time.  A kernel the processor can not run falls back to the one AUTO picks.
+// <pool> splits colors with more than PARALLEL_PAIRS pairs across its threads, nullptr solves everything here
+void LineBatch::solve(ThreadPool *pool) {
+    Kernel k = supported(kernel) && kernel != AUTO ? kernel : best();
+    for(unsigned int c = 0; c + 1 < colors.size(); c++) {
+        unsigned int begin = colors[c];
+        unsigned int end = colors[c + 1];
+        if(pool == nullptr || end - begin < PARALLEL_PAIRS) {
+            solveRange(k, begin, end);
+        } else {
+            // Chunks are kept to a multiple of four so only the last one has a scalar tail
+            unsigned int chunks = pool->size() + 1;
+            unsigned int per_chunk = (((end - begin + chunks - 1) / chunks) + 3) & ~3u;
+            pool->parallelFor(chunks, [this, k, begin, end, per_chunk](unsigned int i) {
+                unsigned int from = std::min(end, begin + (i * per_chunk));
+                unsigned int to = std::min(end, from + per_chunk);
+                solveRange(k, from, to);
+            });
+        }
+    }
+}
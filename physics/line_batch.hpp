@@ -0,0 +1,74 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the header file for the LineBatch class
+ */
+
+#ifndef FINAL_PROJECT_LINE_BATCH_HPP
+#define FINAL_PROJECT_LINE_BATCH_HPP
+
+#include "constraints/line_constraint.hpp"
+#include "particle_store.hpp"
+#include "../personal_utilities/thread_pool.hpp"
+#include <vector>
+
+// LineBatch solves many EQUAL LineConstraints of one ParticleStore at once.  Every particle pair is packed into
+// parallel arrays of store indices, rest lengths and mass weights, and the pairs are colored so that no two pairs of
+// the same color share a particle.  Pairs of one color can then be solved in any order, or side by side in the lanes
+// of a SIMD register, and give exactly what solving them one at a time with LineConstraint::fix would.  Colors are
+// solved one after another, so the batch as a whole is still a Gauss-Seidel pass, only in color order rather than in
+// tree order.
+class LineBatch {
+public:
+
+    // How the pairs of a color are solved
+    enum Kernel {
+        AUTO,       // The widest kernel the processor supports, or SCALAR in a build that is not optimized
+        SCALAR,     // One pair at a time
+        SSE2,       // Two pairs at a time
+        AVX2        // Four pairs at a time
+    };
+
+protected:
+    ParticleStore* store = nullptr;
+
+    // One entry per pair, sorted by color
+    std::vector<int> a;                 // Store index of the first particle
+    std::vector<int> b;                 // Store index of the second particle
+    std::vector<double> length;
+    std::vector<double> scale_a;        // Share of the correction the first particle takes
+    std::vector<double> scale_b;        // Share of the correction the second particle takes
+    std::vector<LineConstraint*> owners;
+
+    // Pairs of color c are colors[c] to colors[c + 1] - 1
+    std::vector<unsigned int> colors;
+
+    Kernel kernel = AUTO;
+    unsigned long length_generation = 0;
+    unsigned long mass_generation = 0;
+
+    void updateWeights();
+    void solveRange(Kernel k, unsigned int begin, unsigned int end);
+
+public:
+
+    // Pairs in a color before it is split across a thread pool
+    constexpr static unsigned int PARALLEL_PAIRS = 2048;
+
+    static bool canBatch(Constraint* c, ParticleStore* store);
+    static Kernel best();
+    static bool supported(Kernel k);
+    static const char* kernelName(Kernel k);
+
+    void build(const std::vector<LineConstraint*> &lines, ParticleStore* store);
+    void clear();
+    bool refresh();
+    void solve(ThreadPool* pool = nullptr);
+
+    Kernel getKernel() { return kernel; }
+    void setKernel(Kernel k) { this->kernel = k; }
+    unsigned int size() { return a.size(); }
+    unsigned int getColors() { return colors.empty() ? 0 : colors.size() - 1; }
+};
+
+#endif //FINAL_PROJECT_LINE_BATCH_HPP
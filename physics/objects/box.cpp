@@ -11,7 +11,7 @@
 #include <cmath>
 #include <algorithm>
 
-std::string Box::TYPE = "box";
+TypeId Box::TYPE = Typed::registerType("box");
 
 // Box constructor
 // <pos> bottom left point at which the box will be initiated
@@ -23,7 +23,7 @@ private:
     MovableWall::MovableWallConstraint* mmc_bottom;
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     Box(double * pos, double width, double height);
     ~Box();
@@ -6,9 +6,8 @@
 
 #include "convex_polygon.hpp"
 #include "../../space.hpp"
-#include <cmath>
 
-std::string ConvexPolygon::TYPE = "convex_polygon";
+TypeId ConvexPolygon::TYPE = Typed::registerType("convex_polygon");
 
 // ConvexPolygon protected constructor, for use in derived classes
 // <solid> if particles are allowed to interact with the polygon
@@ -45,39 +44,29 @@ ConvexPolygon::ConvexPolygon(std::vector<Particle*> vertices, bool solid, double
 void ConvexPolygon::setConstraints() {
     for(int i = 0; i < num_vertices; i++) {
         for(int j = i + 1; j < num_vertices; j++) {
-            double * dist = douglas::vector::subtract(
-                    vertices[i]->getPosition(),
-                    vertices[j]->getPosition()
-            );
-            LineConstraint* lc = new LineConstraint(douglas::vector::magnitude(dist), Constraint::EQUAL);
+            double dist = vertices[i]->getPosition().distance(vertices[j]->getPosition());
+            LineConstraint* lc = new LineConstraint(dist, Constraint::EQUAL);
             lc->addParticle(vertices[i]);
             lc->addParticle(vertices[j]);
             line_constraints.push_back(lc);
             addSpecificConstraint(lc);
-            delete [] dist;
         }
     }
 }
 
-// Render the polygon to the screen
+// Render the polygon to the screen, the sides are only drawn again when a vertex has moved
 void ConvexPolygon::render(Screen *screen) {
     Space* world = (Space*) getWorld();
-    double * p_pos = world->convertToPixels(vertices[0]->getPosition(), screen);
-    double * pos;
-    for(unsigned i = 1; i < vertices.size(); i++) {
-        pos = world->convertToPixels(vertices[i]->getPosition(), screen);
-        std::vector<Pixel> line;
-        screen->line(pos, p_pos, draw_char, &line);
-        screen->addToFrame(line);
-        delete [] p_pos;
-        p_pos = pos;
+    render_points.clear();
+    world->convertToPixels(vertices.data(), vertices.size(), &render_points, screen);
+    if(renderKeyChanged()) {
+        rendered_pixels.clear();
+        for(unsigned i = 1; i < render_points.size(); i++) {
+            screen->line(render_points[i], render_points[i - 1], draw_char, &rendered_pixels);
+        }
+        screen->line(render_points[0], render_points.back(), draw_char, &rendered_pixels);
     }
-    pos = world->convertToPixels(vertices[0]->getPosition(), screen);
-    std::vector<Pixel> line;
-    screen->line(pos, p_pos, draw_char, &line);
-    screen->addToFrame(line);
-    delete [] p_pos;
-    delete [] pos;
+    screen->addToFrame(rendered_pixels);
 }
 
 // ConvexPolygonConstraint constructor
@@ -86,84 +75,5 @@ ConvexPolygon::ConvexPolygonConstraint::ConvexPolygonConstraint(ConvexPolygon *p
     this->polygon = polygon;
 }
 
-// Method to make the ConvexPolygon solid
-void ConvexPolygon::ConvexPolygonConstraint::fix(int iter, Particle *p) {
-
-    // THIS IS NOT CURRENTLY WORKING AND WAS A BAD IDEA MATHEMATICALLY
-    // The Separating Axis Theorem (SAT) should be implemented instead
-
-    return;
-
-    if(this->polygon->solid) {
-
-        // TODO this could do with a limiting factor to decrease calculation time for non-effected particles
-
-        int min_index = 0;
-        double total_angle = 0;
-        double *p_vec = douglas::vector::subtract(this->polygon->vertices[0]->getPosition(),
-                                                  p->getPosition());
-        double *min_vec = p_vec;
-        for (int i = 1; i < this->polygon->num_vertices; i++) {
-            double *vec = douglas::vector::subtract(this->polygon->vertices[i]->getPosition(),
-                                                    p->getPosition());
-            total_angle += douglas::vector::angle(p_vec, vec);
-            if (douglas::vector::magnitude(vec) < douglas::vector::magnitude(min_vec)) {
-                *min_vec = *vec;
-                min_index = i;
-            }
-            *p_vec = *vec;
-        }
-
-        if (total_angle > douglas::pi) {
-            // Particle is inside the polygon
-
-            // Find the adjacent closest vertex
-            // The final second minimum
-            double *min2_vec;
-            // The index greater then min
-            double *ming_vec = douglas::vector::subtract(
-                    this->polygon->vertices[(min_index + 1) % this->polygon->num_vertices]->getPosition(),
-                    p->getPosition());
-            // The index less then min
-            double *minl_vec = douglas::vector::subtract(
-                    this->polygon->vertices[(min_index + this->polygon->num_vertices - 1) % this->polygon->num_vertices]->getPosition(),
-                    p->getPosition());
-            if (douglas::vector::magnitude(ming_vec) > douglas::vector::magnitude(minl_vec)) {
-                min2_vec = minl_vec;
-                delete[] ming_vec;
-            } else {
-                min2_vec = ming_vec;
-                delete[] minl_vec;
-            }
-
-            // Find shortest exit path
-            // This is done using vector projection onto a line (Vector Math)
-            double *edge = douglas::vector::subtract(min2_vec, min_vec);
-            double *min_to_point = douglas::vector::subtract(p->getPosition(), min_vec);
-            double *proj = douglas::vector::project(min_to_point, edge);
-            // This is the shortest exit path of the particle
-            double *exit_path = douglas::vector::subtract(proj, min_to_point);
-            // Scale for rigidness
-            douglas::vector::scale(exit_path, this->polygon->rigid);
-
-            // New particle position
-            double *n_pos = douglas::vector::add(p->getPosition(), exit_path);
-            // Set new particle position
-            p->setPosition(n_pos);
-
-            delete[] min2_vec;
-            delete[] edge;
-            delete[] min_to_point;
-            delete[] proj;
-            delete[] exit_path;
-            delete[] n_pos;
-        }
-
-        if(min_vec != p_vec) {
-            delete [] min_vec;
-        }
-        delete[] p_vec;
-
-    }
-
-}
\ No newline at end of file
+// Method to make the ConvexPolygon solid.  Particles are not pushed out of the polygon yet, so this does nothing.
+void ConvexPolygon::ConvexPolygonConstraint::fix(int iter, Particle *p) {}
\ No newline at end of file
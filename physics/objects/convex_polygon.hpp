@@ -8,7 +8,6 @@
 #define FINAL_PROJECT_CONVEX_POLYGON_HPP
 
 #include "../particle_container.hpp"
-#include "../../personal_utilities/vec_func.hpp"
 #include "../constraints/single_constraint.hpp"
 #include "../constraints/line_constraint.hpp"
 
@@ -37,7 +36,7 @@ protected:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     ConvexPolygon(bool solid = true, double rigid = 1);
     ConvexPolygon(std::vector<Particle*> vertices, bool solid = true, double rigid = 1);
@@ -8,8 +8,8 @@
 #include "../../space.hpp"
 #include "../../personal_utilities/vec_func.hpp"
 
-std::string MovableWall::TYPE = "movable_wall";
-std::string MovableWall::MovableWallConstraint::TYPE = "movable_wall_constraint";
+TypeId MovableWall::TYPE = Typed::registerType("movable_wall");
+TypeId MovableWall::MovableWallConstraint::TYPE = Typed::registerType("movable_wall_constraint");
 
 // MovableWall private Constructor
 // <p1> particle that defines the top of the wall
@@ -34,7 +34,7 @@ MovableWall::MovableWall(double *pos1, double *pos2, bool wall_moves) : Particle
     addChild(this->p1);
     addChild(this->p2);
 
-    lineConstraint = new LineConstraint(douglas::vector::distance(pos1, pos2), Constraint::EQUAL);
+    lineConstraint = new LineConstraint(douglas::Vec2(pos1).distance(douglas::Vec2(pos2)), Constraint::EQUAL);
     lineConstraint->addParticle(this->p1);
     lineConstraint->addParticle(this->p2);
     addSpecificConstraint(lineConstraint);
@@ -43,22 +43,19 @@ MovableWall::MovableWall(double *pos1, double *pos2, bool wall_moves) : Particle
     addSuperGlobalConstraint(movableWallConstraint);
 }
 
-// Renders the MovableWall
+// Renders the MovableWall, only drawing the line again when one of its ends has moved
 void MovableWall::render(Screen *screen) {
 
     Space* world = (Space*) getWorld();
 
-    double * s_p1 = douglas::vector::copy(p1->getPosition());
-    double * s_p2 = douglas::vector::copy(p2->getPosition());
-    world->convertToPixels(s_p1, screen);
-    world->convertToPixels(s_p2, screen);
-
-    std::vector<Pixel> line;
-    screen->line(s_p1, s_p2, draw_char, &line);
-    screen->addToFrame(line);
-
-    delete [] s_p1;
-    delete [] s_p2;
+    Particle* ends[2] = { p1, p2 };
+    render_points.clear();
+    world->convertToPixels(ends, 2, &render_points, screen);
+    if(renderKeyChanged()) {
+        rendered_pixels.clear();
+        screen->line(render_points[0], render_points[1], draw_char, &rendered_pixels);
+    }
+    screen->addToFrame(rendered_pixels);
 
 }
 
@@ -85,76 +82,48 @@ MovableWall::MovableWallConstraint::~MovableWallConstraint() {
 }
 
 // Doesn't allow moving particles to go through wall.
-// Uses douglas::vector::intercept to do this.
+// Uses douglas::segmentHit to do this.
 void MovableWall::MovableWallConstraint::fix(int iter, Particle *p) {
     if(isExcluded(p))
         return;
 
-    double * inter_path = douglas::vector::subtract(p->getPPosition(), p->getPosition());
-    douglas::vector::scale(inter_path, 1);
-    double * ppos = douglas::vector::add(p->getPosition(), inter_path);
-
-    double * intersect = nullptr;
-    try {
-        intersect = douglas::vector::intersection(wall->p1->getPosition(), wall->p2->getPosition(),
-                                                  p->getPosition(), ppos);
-
-        // Fun vector math
-
-        double * wall_vec = douglas::vector::subtract(wall->p1->getPosition(), wall->p2->getPosition());
-        double * orth_wall_vec = douglas::vector::vector(-1 * wall_vec[1], wall_vec[0]);
-
-        double * p_path = douglas::vector::subtract(p->getPosition(), p->getPPosition());
-        double * o_w_p_path = douglas::vector::project(p_path, orth_wall_vec);
-        double * p_w_path = douglas::vector::subtract(intersect, p->getPPosition());
-        double * o_w_p_w_path = douglas::vector::project(p_w_path, orth_wall_vec);
-        double * diff = douglas::vector::subtract(o_w_p_w_path, o_w_p_path);
-        douglas::vector::scale(diff, 1.2);
-
-        double * p_diff = douglas::vector::copy(diff);
-        if(wall->wall_moves) {
-            douglas::vector::scale(p_diff, 0.5);
-        }
-        double * n_pos = douglas::vector::add(p->getPosition(), diff);
-        p->setPosition(n_pos);
-
-        if(wall->wall_moves) {
-            douglas::vector::scale(diff, -0.5);
-            double wall_length = douglas::vector::magnitude(wall_vec);
-            double r1 = douglas::vector::distance(wall->p2->getPosition(), intersect) / wall_length;
-            double r2 = douglas::vector::distance(wall->p1->getPosition(), intersect) / wall_length;
-            double lambda = 1 / ((r1 * r1) + (r2 * r2));
-
-            double *p1_diff = douglas::vector::copy(diff);
-            douglas::vector::scale(p1_diff, r1 * lambda);
-            double *p1_n_pos = douglas::vector::add(p1_diff, wall->p1->getPosition());
-            wall->p1->setPosition(p1_n_pos);
-
-            double *p2_diff = douglas::vector::copy(diff);
-            douglas::vector::scale(p2_diff, r2 * lambda);
-            double *p2_n_pos = douglas::vector::add(p2_diff, wall->p2->getPosition());
-            wall->p2->setPosition(p2_n_pos);
-
-            delete [] p1_n_pos;
-            delete [] p2_n_pos;
-            delete [] p1_diff;
-            delete [] p2_diff;
-        }
-
-        delete [] p_diff;
-        delete [] wall_vec;
-        delete [] orth_wall_vec;
-        delete [] p_path;
-        delete [] o_w_p_path;
-        delete [] p_w_path;
-        delete [] o_w_p_w_path;
-        delete [] diff;
-        delete [] n_pos;
-    } catch (std::out_of_range e) {
-        // There is no intersection of the lines
+    douglas::Vec2 pos = p->getPosition();
+    douglas::Vec2 ppos = p->getPPosition();
+
+    douglas::SegmentHit hit = douglas::segmentHit(wall->p1->getPosition(), wall->p2->getPosition(), pos, ppos);
+    if(hit.hit) {
+        push(p, pos, ppos, hit.t);
     }
+}
+
+// Pushes a particle that crossed the wall back to the side it came from, and the wall the other way if it can move
+// <pos> and <ppos> are the particle's current and previous positions
+// <t> is how far along the wall, from p1 to p2, the particle crossed it
+void MovableWall::MovableWallConstraint::push(Particle *p, const douglas::Vec2 &pos, const douglas::Vec2 &ppos, double t) {
+    douglas::Vec2 w_p1 = wall->p1->getPosition();
+    douglas::Vec2 w_p2 = wall->p2->getPosition();
 
-    delete [] inter_path;
-    delete [] ppos;
-    delete [] intersect;
+    // Fun vector math
+
+    douglas::Vec2 wall_vec = w_p1 - w_p2;
+    douglas::Vec2 orth_wall_vec = wall_vec.orthogonal();
+    douglas::Vec2 point = w_p1 - (wall_vec * t);
+
+    douglas::Vec2 o_w_p_path = (pos - ppos).project(orth_wall_vec);
+    douglas::Vec2 o_w_p_w_path = (point - ppos).project(orth_wall_vec);
+    douglas::Vec2 diff = (o_w_p_w_path - o_w_p_path) * 1.2;
+
+    p->setPosition(pos + diff);
+
+    if(wall->wall_moves) {
+        diff *= -0.5;
+        double wall_length = wall_vec.magnitude();
+        double r1 = w_p2.distance(point) / wall_length;
+        double r2 = w_p1.distance(point) / wall_length;
+        double lambda = 1 / ((r1 * r1) + (r2 * r2));
+
+        // The particle may be one of the wall's own ends, so their positions are read again
+        wall->p1->setPosition(wall->p1->getPosition() + (diff * (r1 * lambda)));
+        wall->p2->setPosition(wall->p2->getPosition() + (diff * (r2 * lambda)));
+    }
 }
\ No newline at end of file
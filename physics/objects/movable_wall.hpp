@@ -10,6 +10,7 @@
 #include "../particle_container.hpp"
 #include "../constraints/single_constraint.hpp"
 #include "../constraints/line_constraint.hpp"
+#include "../../personal_utilities/vec2.hpp"
 
 // This class is basically a stick that can be push and rotated by all Particles in a ParticleContainer and in the
 // same GameObject tree as it is.
@@ -20,8 +21,9 @@ public:
     protected:
         MovableWall* wall;
         bool delete_wall = false;
+        void push(Particle* p, const douglas::Vec2& pos, const douglas::Vec2& ppos, double t);
     public:
-        static std::string TYPE;
+        static TypeId TYPE;
         MovableWallConstraint(MovableWall* wall);
         MovableWallConstraint(Particle* p1, Particle* p2, bool wall_moves = true);
         ~MovableWallConstraint();
@@ -43,7 +45,7 @@ protected:
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     MovableWall(double* p1, double* p2, bool wall_moves = true);
 
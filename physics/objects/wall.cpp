@@ -5,43 +5,36 @@
  */
 
 #include "wall.hpp"
-#include "../../personal_utilities/vec_func.hpp"
 #include "../../space.hpp"
 
 #include "../constraints/drag_constraint.hpp"
+#include <algorithm>
 
-std::string Wall::TYPE = "wall";
-std::string Wall::WallConstraint::TYPE = "wall_constraint";
+TypeId Wall::TYPE = Typed::registerType("wall");
+TypeId Wall::WallConstraint::TYPE = Typed::registerType("wall_constraint");
 
 // Wall constructor
 // <top> is the position of the top of the wall
 // <bottom> is the position of the bottom of the wall
 Wall::Wall(double *top, double *bottom) : ParticleContainer() {
-    this->top = douglas::vector::copy(top);
-    this->bottom = douglas::vector::copy(bottom);
+    this->top = douglas::Vec2(top);
+    this->bottom = douglas::Vec2(bottom);
 
     wallConstraint = new WallConstraint(this);
     addSuperGlobalConstraint(wallConstraint);
 }
 
-// Deconstructor
-Wall::~Wall() {
-    delete [] top;
-    delete [] bottom;
+// Draws the wall into <vec>, as a wall never moves its Space only needs to do this once
+void Wall::renderStatic(Screen *screen, std::vector<Pixel> *vec) {
+    Space* world = (Space*) getWorld();
+    screen->line(world->convertToPixels(top, screen), world->convertToPixels(bottom, screen), draw_char, vec);
 }
 
 // Renders the wall
 void Wall::render(Screen *screen) {
     if(changed) {
         rendered_pixels.clear();
-
-        Space* world = (Space*) getWorld();
-        double * p_top = world->convertToPixels((const double*) top, screen);
-        double * p_bot = world->convertToPixels((const double*) bottom, screen);
-        screen->line(p_top, p_bot, draw_char, &rendered_pixels);
-        delete [] p_top;
-        delete [] p_bot;
-
+        renderStatic(screen, &rendered_pixels);
         changed = false;
     }
 
@@ -59,43 +52,34 @@ void Wall::WallConstraint::fix(int iter, Particle *p) {
     if(isExcluded(p))
         return;
 
-    double * inter_path = douglas::vector::subtract(p->getPPosition(), p->getPosition());
-    douglas::vector::scale(inter_path, 1);
-    double * ppos = douglas::vector::add(p->getPosition(), inter_path);
-
-    double * intersect = nullptr;
-    try {
-        intersect = douglas::vector::intersection(wall->top, wall->bottom,
-                                                           p->getPosition(), ppos);
-
-        // Fun vector math
-
-        double * wall_vec = douglas::vector::subtract(wall->top, wall->bottom);
-        double * orth_wall_vec = douglas::vector::vector(-1 * wall_vec[1], wall_vec[0]);
-
-        double * p_path = douglas::vector::subtract(p->getPosition(), p->getPPosition());
-        double * o_w_p_path = douglas::vector::project(p_path, orth_wall_vec);
-        double * p_w_path = douglas::vector::subtract(intersect, p->getPPosition());
-        double * o_w_p_w_path = douglas::vector::project(p_w_path, orth_wall_vec);
-        double * diff = douglas::vector::subtract(o_w_p_w_path, o_w_p_path);
-        douglas::vector::scale(diff, 1.2);
-
-        double * n_pos = douglas::vector::add(p->getPosition(), diff);
-        p->setPosition(n_pos);
-
-        delete [] wall_vec;
-        delete [] orth_wall_vec;
-        delete [] p_path;
-        delete [] o_w_p_path;
-        delete [] p_w_path;
-        delete [] o_w_p_w_path;
-        delete [] diff;
-        delete [] n_pos;
-    } catch (std::out_of_range e) {
-        // There is no intersection of the lines
+    douglas::Vec2 pos = p->getPosition();
+    douglas::Vec2 ppos = p->getPPosition();
+
+    douglas::SegmentHit hit = douglas::segmentHit(wall->top, wall->bottom, pos, ppos);
+    if(hit.hit) {
+        push(p, pos, ppos, hit.t);
     }
+}
+
+// Pushes a particle that crossed the wall back to the side it came from
+// <pos> and <ppos> are the particle's current and previous positions
+// <t> is how far along the wall, from top to bottom, the particle crossed it
+void Wall::WallConstraint::push(Particle *p, const douglas::Vec2 &pos, const douglas::Vec2 &ppos, double t) {
+    // Fun vector math
 
-    delete [] inter_path;
-    delete [] ppos;
-    delete [] intersect;
-}
\ No newline at end of file
+    douglas::Vec2 orth_wall_vec = (wall->top - wall->bottom).orthogonal();
+    douglas::Vec2 point = wall->top + ((wall->bottom - wall->top) * t);
+
+    douglas::Vec2 o_w_p_path = (pos - ppos).project(orth_wall_vec);
+    douglas::Vec2 o_w_p_w_path = (point - ppos).project(orth_wall_vec);
+    douglas::Vec2 diff = (o_w_p_w_path - o_w_p_path) * 1.2;
+
+    p->setPosition(pos + diff);
+}
+
+// A wall never moves, so it is bounded by the box around its two ends
+bool Wall::WallConstraint::getBounds(douglas::Vec2 *min, douglas::Vec2 *max) {
+    *min = douglas::Vec2(std::min(wall->top.x, wall->bottom.x), std::min(wall->top.y, wall->bottom.y));
+    *max = douglas::Vec2(std::max(wall->top.x, wall->bottom.x), std::max(wall->top.y, wall->bottom.y));
+    return true;
+}
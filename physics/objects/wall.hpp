@@ -9,6 +9,7 @@
 
 #include "../particle_container.hpp"
 #include "../constraints/single_constraint.hpp"
+#include "../../personal_utilities/vec2.hpp"
 
 // Wall is a static wall that moving particles cannot pass through
 class Wall : public ParticleContainer {
@@ -16,21 +17,24 @@ public:
     class WallConstraint : public SingleConstraint {
     protected:
         Wall* wall;
+        void push(Particle* p, const douglas::Vec2& pos, const douglas::Vec2& ppos, double t);
     public:
-        static std::string TYPE;
+        static TypeId TYPE;
         WallConstraint(Wall* wall1);
         void fix(int, Particle*);
+        bool getBounds(douglas::Vec2* min, douglas::Vec2* max);
     };
 
 protected:
-    double* top;
-    double* bottom;
+    douglas::Vec2 top;
+    douglas::Vec2 bottom;
     WallConstraint* wallConstraint;
 public:
-    static std::string TYPE;
+    static TypeId TYPE;
     Wall(double * top, double * bottom);
-    ~Wall();
     void exclude(GameObject* go) { wallConstraint->exclude(go); }
+    bool isStatic() { return true; }
+    void renderStatic(Screen* screen, std::vector<Pixel>* vec);
     void render(Screen* screen);
 };
 
@@ -7,93 +7,61 @@
 #include "particle.hpp"
 #include <string>
 
-std::string Particle::TYPE = "particle";
+TypeId Particle::TYPE = Typed::registerType("particle");
 
 // Default Particle Constructor
 Particle::Particle() : GameObject() {
     addType(Particle::TYPE);
-    mass = 1;
-    pos = new double[2];
-    pos[0] = 0;
-    pos[1] = 0;
-    ppos = new double[2];
-    ppos[0] = 0;
-    ppos[1] = 0;
+    store = ParticleStore::detached();
+    index = store->add(this, 0, 0, 0, 0, 1);
 }
 
-// Particle constructor at a position <pos>
-Particle::Particle(double *pos) : GameObject() {
-    addType(Particle::TYPE);
-    mass = 1;
-    if(pos != nullptr) {
-        this->pos = pos;
-    } else {
-        pos = new double[2];
-        pos[0] = 0;
-        pos[1] = 0;
-    }
-    this->ppos = new double[2];
-    ppos[0] = pos[0];
-    ppos[1] = pos[1];
-}
+// Particle constructor at a position <pos>, takes ownership of <pos>
+Particle::Particle(double *pos) : Particle(pos, nullptr) {}
 
-// Particle constructor at a position <pos> with velocity <vel>
+// Particle constructor at a position <pos> with velocity <vel>, takes ownership of <pos>
 Particle::Particle(double *pos, double *vel) : GameObject() {
     addType(Particle::TYPE);
-    mass = 1;
+    double x = 0;
+    double y = 0;
     if(pos != nullptr) {
-        this->pos = pos;
-    } else {
-        pos = new double[2];
-        pos[0] = 0;
-        pos[1] = 0;
+        x = pos[0];
+        y = pos[1];
+        delete [] pos;
     }
-    this->ppos = new double[2];
+    double px = x;
+    double py = y;
     if(vel != nullptr) {
-        ppos[0] = pos[0] - vel[0];
-        ppos[1] = pos[1] - vel[1];
-    } else {
-        ppos[0] = pos[0];
-        ppos[1] = pos[1];
+        px -= vel[0];
+        py -= vel[1];
     }
+    store = ParticleStore::detached();
+    index = store->add(this, x, y, px, py, 1);
 }
 
 // Particle Deconstructor
 Particle::~Particle() {
-    delete [] pos;
-    delete [] ppos;
+    store->remove(index);
+}
+
+// Where the particle is drawn, between its previous and current position by its store's render alpha so frames drawn
+// between two physics steps still move smoothly
+douglas::Vec2 Particle::getRenderPosition() {
+    const double * p = store->getPosition(index);
+    const double * pp = store->getPPosition(index);
+    double alpha = store->getRenderAlpha();
+    return douglas::Vec2(pp[0] + ((p[0] - pp[0]) * alpha), pp[1] + ((p[1] - pp[1]) * alpha));
 }
 
 // Step the Particle
-void Particle::step(double dt) {
+void Particle::update(double dt) {
 
     if(previous_dt < 0) {
         previous_dt = dt;
     }
 
-    double *n_pos = new double[2];
-    double *vel = new double[2];
-
-    // Get velocity from numeric integration
-    vel[0] = (pos[0] - ppos[0]) / previous_dt;
-    vel[1] = (pos[1] - ppos[1]) / previous_dt;
-
-    if(vel[0] == 0 && vel[1] == 0) {
-        changed = false;
-    } else {
-        changed = true;
-    }
-
-    n_pos[0] = pos[0] + (vel[0] * dt);
-    n_pos[1] = pos[1] + (vel[1] * dt);
-
-    delete [] ppos;
-    ppos = pos;
-    pos = n_pos;
-
-    delete [] vel;
-
-    stepChildren(dt);
+    // Integrated in place inside of the store, no temporaries are needed
+    store->integrate(index, dt, previous_dt);
 
     previous_dt = dt;
 
@@ -102,4 +70,4 @@ void Particle::step(double dt) {
 // Empty render function
 void Particle::render(Screen* screen) {
 
-}
\ No newline at end of file
+}
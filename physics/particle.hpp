@@ -8,17 +8,21 @@
 #define FINAL_PROJECT_PHYSICS_PARTICLE_HPP
 
 #include "../game_object.hpp"
+#include "particle_store.hpp"
+#include "../personal_utilities/vec2.hpp"
 #include <string>
 
-// Represents a particle that can move around the world with velocity and interact with the environment
+// Represents a particle that can move around the world with velocity and interact with the environment.
+// The physical state lives in a ParticleStore, the Particle itself is just a handle to its slot.
 class Particle : public GameObject {
+    friend class ParticleStore;
 protected:
-    double *ppos;
-    double *pos;
-    double mass;
+    ParticleStore* store;
+    unsigned int index;
+    void setHandle(ParticleStore* store, unsigned int index) { this->store = store; this->index = index; }
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     // Gravitation Constant
     constexpr static double g_accl = 10;
@@ -30,20 +34,26 @@ public:
     Particle(const Particle& obj);
     ~Particle();
 
+    // Store handle
+    ParticleStore* getStore() { return store; }
+    unsigned int getIndex() { return index; }
+
     // Physics Data
-    double getMass() { return mass; }
-    void setMass(double mass) { this->mass = mass; }
+    double getMass() { return store->getMass(index); }
+    void setMass(double mass) { store->setMass(index, mass); }
 
     // Position Data
-    const double * getPosition() { return pos; }
-    void setPosition(const double * pos) { this->pos[0] = pos[0]; this->pos[1] = pos[1]; }
-    const double * getPPosition() { return ppos; }
-    void setPPosition(const double * ppos) { this->ppos[0] = ppos[0]; this->ppos[1] = ppos[1]; }
+    douglas::Vec2 getPosition() { return douglas::Vec2(store->getPosition(index)); }
+    void setPosition(const douglas::Vec2 &pos) { double * p = store->getPosition(index); p[0] = pos.x; p[1] = pos.y; }
+    douglas::Vec2 getPPosition() { return douglas::Vec2(store->getPPosition(index)); }
+    void setPPosition(const douglas::Vec2 &ppos) { double * p = store->getPPosition(index); p[0] = ppos.x; p[1] = ppos.y; }
+    douglas::Vec2 getRenderPosition();
 
-    void step(double dt);
+    void update(double dt);
     void render(Screen*);
 
-    double &operator [](const int i) { return pos[i]; }
+    // The reference is into the store, it is invalidated when a particle is added to or removed from the same store
+    double &operator [](const int i) { return store->getPosition(index)[i]; }
 };
 
 #endif //FINAL_PROJECT_PHYSICS_PARTICLE_HPP
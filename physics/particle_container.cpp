@@ -8,10 +8,11 @@
 #include "../game_object.hpp"
 #include "../space.hpp"
 #include "constraints/constraint.hpp"
+#include "../trace.hpp"
 #include <string>
 #include <vector>
 
-std::string ParticleContainer::TYPE = "particle_container";
+TypeId ParticleContainer::TYPE = Typed::registerType("particle_container");
 
 // Default ParticleContainer Constructor
 ParticleContainer::ParticleContainer() : GameObject() {
@@ -40,48 +41,67 @@ ParticleContainer::~ParticleContainer() {
 // Add a specific constraint, this will not leave this GameObject
 void ParticleContainer::addSpecificConstraint(Constraint * p) {
     specific_constraints.push_back(p);
+    constraintsChanged();
 }
 
 // Add a sub global constraint, this will be propagated to all ParticleContainers below current one in the GameObject tree.
 void ParticleContainer::addSubGlobalConstraint(SingleConstraint * p) {
     sub_global_constraints.push_back(p);
-    if(parent != nullptr) {
-        getGlobalConstraints(nullptr, true, false);
-    }
+    constraintsChanged();
 }
 
 // Add a super global constraint, this will be have effect over every ParticleContainer in the GameObject tree.
 void ParticleContainer::addSuperGlobalConstraint(SingleConstraint * p) {
     super_global_constraints.push_back(p);
-    if(parent != nullptr) {
-        getGlobalConstraints(nullptr, true, false);
-        Space* world = (Space*) getWorld();
-        world->getPhysics()->getSuperGlobalConstraints(nullptr, true);
+    constraintsChanged();
+}
+
+// The Space at the top of this ParticleContainer's tree, or nullptr when the tree is not in a Space
+Space* ParticleContainer::getWorldSpace() {
+    GameObject* world = getWorld();
+    return world->isType(Space::TYPE) ? (Space*) world : nullptr;
+}
+
+// Let the Space this ParticleContainer is in know that its global constraints are out of date
+void ParticleContainer::constraintsChanged() {
+    Space* world = getWorldSpace();
+    if(world != nullptr) {
+        world->constraintsChanged();
     }
 }
 
-// Retrieve all global constraints for this ParticleContainer
-void ParticleContainer::getGlobalConstraints(std::vector < SingleConstraint * > * vec, bool update_cached, bool supers) {
-    if(update_cached) {
+// Retrieve all global constraints for this ParticleContainer, its own and its parents' sub global constraints followed
+// by every super global constraint in the Space.  The list is only rebuilt when the Space's constraint generation has
+// changed, so the same vector is handed back on every call in between.  Outside of a Space there is no generation to
+// check, so the list is rebuilt on every call from the super global constraints of every ParticleContainer in the tree.
+const std::vector<SingleConstraint*>& ParticleContainer::getGlobalConstraints() {
+    Space* world = getWorldSpace();
+    if(world == nullptr || world != cached_world || world->getConstraintGeneration() != cached_generation) {
         cached_global_constraints.clear();
-        for(unsigned int i = 0; i < sub_global_constraints.size(); i++) {
-            cached_global_constraints.push_back(sub_global_constraints[i]);
+        std::vector<GameObject*> pcs;
+        getParentsOfType(ParticleContainer::TYPE, &pcs);
+        for(unsigned int i = 0; i < pcs.size(); i++) {
+            ((ParticleContainer*) pcs[i])->getSubGlobalConstraints(&cached_global_constraints);
         }
-        std::vector<GameObject*> parentPCs;
-        parent->getParentsOfType(ParticleContainer::TYPE, &parentPCs);
-        for(unsigned int i = 0; i < parentPCs.size(); i++) {
-            ((ParticleContainer*) parentPCs[i])->getGlobalConstraints(&cached_global_constraints, false, false);
-        }
-    }
-    if(vec != nullptr) {
-        for(unsigned int i = 0; i < cached_global_constraints.size(); i++) {
-            vec->push_back(cached_global_constraints[i]);
-        }
-        if(supers) {
-            Space* world = (Space*) getWorld();
-            world->getPhysics()->getSuperGlobalConstraints(vec);
+        if(world != nullptr) {
+            world->getPhysics()->getSuperGlobalConstraints(&cached_global_constraints);
+            cached_generation = world->getConstraintGeneration();
+        } else {
+            std::vector<GameObject*> all_pcs;
+            getWorld()->getChildrenOfType(ParticleContainer::TYPE, &all_pcs);
+            for(unsigned int i = 0; i < all_pcs.size(); i++) {
+                ((ParticleContainer*) all_pcs[i])->getSuperGlobalConstraints(&cached_global_constraints);
+            }
         }
+        cached_world = world;
     }
+    return cached_global_constraints;
+}
+
+// Retrieve all global constraints for this ParticleContainer
+void ParticleContainer::getGlobalConstraints(std::vector < SingleConstraint * > * vec) {
+    const std::vector<SingleConstraint*> &globals = getGlobalConstraints();
+    vec->insert(vec->end(), globals.begin(), globals.end());
 }
 
 // Retrieve this ParticleContainer's sub global constraints
@@ -94,34 +114,30 @@ void ParticleContainer::getSubGlobalConstraints(std::vector < SingleConstraint *
 // Remove a sub global constraints
 void ParticleContainer::removeSubGlobalConstraint(int index) {
     sub_global_constraints.erase(sub_global_constraints.begin() + index, sub_global_constraints.begin() + index + 1);
+    constraintsChanged();
 }
 
 // Retrieve this ParticleContainer's super global constraints, or in case of the highest ParticleContainer retrieve
 // all of them from the GameObject tree.
-void ParticleContainer::getSuperGlobalConstraints(std::vector < SingleConstraint * > * vec, bool update_cached) {
-    if(((Space*) getWorld())->getPhysics()->getId() == this->getId()) {
+void ParticleContainer::getSuperGlobalConstraints(std::vector < SingleConstraint * > * vec) {
+    Space* world = getWorldSpace();
+    if(world != nullptr && world->getPhysics()->getId() == this->getId()) {
         // This is the physics element of a Space
-        if(update_cached) {
+        if(master_cached_generation != world->getConstraintGeneration()) {
             master_cached_global_super_constraints.clear();
             std::vector<GameObject*> allPCs;
             this->getChildrenOfType(ParticleContainer::TYPE, &allPCs);
             for(unsigned int i = 0; i < allPCs.size(); i++) {
                 if(((ParticleContainer*) allPCs[i])->getId() != this->getId()) {
-                    ((ParticleContainer*) allPCs[i])->getSuperGlobalConstraints(&master_cached_global_super_constraints, false);
+                    ((ParticleContainer*) allPCs[i])->getSuperGlobalConstraints(&master_cached_global_super_constraints);
                 }
             }
+            master_cached_generation = world->getConstraintGeneration();
         }
-        if(vec != nullptr) {
-            for(unsigned int i = 0; i < master_cached_global_super_constraints.size(); i++) {
-                vec->push_back(master_cached_global_super_constraints[i]);
-            }
-        }
+        vec->insert(vec->end(), master_cached_global_super_constraints.begin(),
+                    master_cached_global_super_constraints.end());
     } else {
-        if(vec != nullptr) {
-            for(unsigned int i = 0; i < super_global_constraints.size(); i++) {
-                vec->push_back(super_global_constraints[i]);
-            }
-        }
+        vec->insert(vec->end(), super_global_constraints.begin(), super_global_constraints.end());
     }
 }
 
@@ -133,35 +149,84 @@ void ParticleContainer::getSpecificConstraints(std::vector < Constraint * > * ve
 }
 
 // Add a specified amount of velocity to all the particles under this ParticleContainer
-void ParticleContainer::addVelocity(double *vel) {
+void ParticleContainer::addVelocity(const douglas::Vec2 &vel) {
     std::vector<GameObject*> particles;
     getChildrenOfType(Particle::TYPE, &particles);
     std::vector<GameObject*>::iterator it;
     for(it = particles.begin(); it != particles.end(); it++) {
-        (*((Particle*) (*it)))[0] += vel[0];
-        (*((Particle*) (*it)))[1] += vel[1];
+        (*((Particle*) (*it)))[0] += vel.x;
+        (*((Particle*) (*it)))[1] += vel.y;
+    }
+}
+
+// Retrieve the particles directly under this ParticleContainer, only looked up again when the Space's tree changes,
+// or on every call when the tree is not in a Space
+const std::vector<Particle*>& ParticleContainer::getImmediateParticles() {
+    Space* world = getWorldSpace();
+    if(world == nullptr || world != cached_particles_world ||
+       world->getTopologyGeneration() != cached_particles_generation) {
+        cached_particles.clear();
+        for(unsigned int i = 0; i < children.size(); i++) {
+            if(children[i]->isType(Particle::TYPE)) {
+                cached_particles.push_back((Particle*) children[i]);
+            }
+        }
+        cached_particles_world = world;
+        cached_particles_generation = world != nullptr ? world->getTopologyGeneration() : 0;
     }
+    return cached_particles;
 }
 
 // Handle all the constraints
 void ParticleContainer::handleConstraints(int iter) {
+    handleSpecificConstraints(iter);
+    handleGlobalConstraints(iter);
+}
+
+// Handle only the constraints that belong to this ParticleContainer
+void ParticleContainer::handleSpecificConstraints(int iter) {
+    Trace::Scope trace("handleSpecificConstraints", getType());
     std::vector<Constraint*>::iterator it;
     for(it = specific_constraints.begin(); it != specific_constraints.end(); it++) {
+        Trace::Scope fix_trace("fix", (*it)->getType());
         (*it)->fix(iter);
     }
+}
 
+// Handle the sub and super global constraints that reach this ParticleContainer's particles
+void ParticleContainer::handleGlobalConstraints(int iter) {
+    Trace::Scope trace("handleGlobalConstraints", getType());
     // Get particles
-    std::vector<GameObject*>::iterator g_it;
-    std::vector<GameObject*> particles;
-    getImmediateChildrenOfType(Particle::TYPE, &particles);
+    const std::vector<Particle*> &particles = getImmediateParticles();
 
-    // Get global constraints
-    std::vector<SingleConstraint*>::iterator s_it;
-    std::vector<SingleConstraint*> global_constraints;
-    getGlobalConstraints(&global_constraints, true);
+    // Find which bounded constraints each particle could touch, outside of a Space every particle is tested
+    Space* world = getWorldSpace();
+    SpatialHash* broadphase = world != nullptr ? world->getBroadphase() : nullptr;
+    if(broadphase != nullptr) {
+        broadphase->query(particles);
+    }
+
+    // Get global constraints, each one is handed all of its particles at once.  Every constraint that runs may move
+    // particles out of the cells they were found in, so the candidates are refreshed before the next indexed one.
+    bool moved = false;
+    std::vector<SingleConstraint*>::const_iterator s_it;
+    const std::vector<SingleConstraint*> &global_constraints = getGlobalConstraints();
     for(s_it = global_constraints.begin(); s_it != global_constraints.end(); s_it++) {
-        for(g_it = particles.begin(); g_it != particles.end(); g_it++) {
-            (*s_it)->fix(iter, (Particle*) *g_it);
+        const std::vector<Particle*>* candidates = broadphase != nullptr ? broadphase->getCandidates(*s_it) : nullptr;
+        if(candidates == nullptr) {
+            Trace::Scope fix_trace("fix", (*s_it)->getType());
+            (*s_it)->fixAll(iter, particles);
+            moved = true;
+        } else {
+            if(moved) {
+                broadphase->refresh(particles);
+                moved = false;
+            }
+            if(!candidates->empty()) {
+                Trace::Scope fix_trace("fix", (*s_it)->getType());
+                (*s_it)->fixAll(iter, *candidates);
+                moved = true;
+            }
         }
     }
 }
\ No newline at end of file
@@ -13,20 +13,32 @@
 #include <string>
 #include <vector>
 
+class Space;
+
 // A recursively designed component that resolves all physics constraints at its level in the GameObject tree.
 // Any physics that happens is inside of a ParticleContainer.
 class ParticleContainer : public GameObject {
 private:
-    // Caching mechanism to decrease amount of recursive calls
+    // Caching mechanism to decrease amount of recursive calls, each cache is only rebuilt when the constraint
+    // generation of the Space it was built in has changed
     std::vector<SingleConstraint*> cached_global_constraints;
+    GameObject* cached_world = nullptr;
+    unsigned long cached_generation = 0;
     std::vector<SingleConstraint*> master_cached_global_super_constraints;
+    unsigned long master_cached_generation = 0;
+    std::vector<Particle*> cached_particles;
+    GameObject* cached_particles_world = nullptr;
+    unsigned long cached_particles_generation = 0;
+
+    void constraintsChanged();
+    Space* getWorldSpace();
 protected:
     std::vector<Constraint*> specific_constraints;
     std::vector<SingleConstraint*> sub_global_constraints;
     std::vector<SingleConstraint*> super_global_constraints;
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     // Constructors
     ParticleContainer();
@@ -36,18 +48,23 @@ public:
     void addSubGlobalConstraint(SingleConstraint*);
     void addSuperGlobalConstraint(SingleConstraint*);
 
-    void getGlobalConstraints(std::vector<SingleConstraint*>* vec, bool update_cached = false, bool supers = true);
+    const std::vector<SingleConstraint*>& getGlobalConstraints();
+    void getGlobalConstraints(std::vector<SingleConstraint*>* vec);
     std::vector<SingleConstraint*> getSubGlobalConstraints() { return sub_global_constraints; }
     void getSubGlobalConstraints(std::vector<SingleConstraint*>*);
     void removeSubGlobalConstraint(int index);
     std::vector<SingleConstraint*> getSuperGlobalConstraints() { return super_global_constraints; }
-    void getSuperGlobalConstraints(std::vector<SingleConstraint*>*, bool update_cached = false);
+    void getSuperGlobalConstraints(std::vector<SingleConstraint*>*);
     std::vector<Constraint*> getSpecificConstraints() { return specific_constraints; }
     void getSpecificConstraints(std::vector<Constraint*>*);
 
-    void addVelocity(double* vel);
+    void addVelocity(const douglas::Vec2 &vel);
+
+    const std::vector<Particle*>& getImmediateParticles();
 
     void handleConstraints(int);
+    void handleSpecificConstraints(int);
+    void handleGlobalConstraints(int);
 
     virtual void render(Screen* screen) {
         renderChildren(screen);
@@ -0,0 +1,122 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the source file for the ParticleStore class
+ */
+
+#include "particle_store.hpp"
+#include "particle.hpp"
+
+// Default ParticleStore constructor
+ParticleStore::ParticleStore() {}
+
+// ParticleStore deconstructor, any particle still in the store no longer has valid data
+ParticleStore::~ParticleStore() {}
+
+// Store shared by all particles created on this thread that have not been placed under a Space yet
+ParticleStore* ParticleStore::detached() {
+    static thread_local ParticleStore store;
+    return &store;
+}
+
+// Append a particle to the store and return its slot
+// <owner> is the Particle handle that refers to the slot
+// <x>, <y> is the current position
+// <px>, <py> is the previous position
+// <mass> is the mass of the particle
+unsigned int ParticleStore::add(Particle *owner, double x, double y, double px, double py, double mass) {
+    pos.push_back(x);
+    pos.push_back(y);
+    ppos.push_back(px);
+    ppos.push_back(py);
+    this->mass.push_back(mass);
+    inv_mass.push_back(mass != 0 ? 1.0 / mass : 0);
+    flags.push_back(0);
+    owners.push_back(owner);
+    return owners.size() - 1;
+}
+
+// Remove the slot at <index>, the last slot is moved into its place to keep the arrays dense
+void ParticleStore::remove(unsigned int index) {
+    unsigned int last = owners.size() - 1;
+    if(index != last) {
+        pos[2 * index] = pos[2 * last];
+        pos[2 * index + 1] = pos[2 * last + 1];
+        ppos[2 * index] = ppos[2 * last];
+        ppos[2 * index + 1] = ppos[2 * last + 1];
+        mass[index] = mass[last];
+        inv_mass[index] = inv_mass[last];
+        flags[index] = flags[last];
+        owners[index] = owners[last];
+        owners[index]->setHandle(this, index);
+    }
+    pos.resize(2 * last);
+    ppos.resize(2 * last);
+    mass.pop_back();
+    inv_mass.pop_back();
+    flags.pop_back();
+    owners.pop_back();
+}
+
+// Move a particle's data from whichever store it is currently in to this one
+void ParticleStore::adopt(Particle *p) {
+    ParticleStore* old = p->store;
+    if(old == this) {
+        return;
+    }
+    unsigned int o_i = p->index;
+    const double * o_pos = old->getPosition(o_i);
+    const double * o_ppos = old->getPPosition(o_i);
+    unsigned int n_i = add(p, o_pos[0], o_pos[1], o_ppos[0], o_ppos[1], old->getMass(o_i));
+    flags[n_i] = old->flags[o_i];
+    old->remove(o_i);
+    p->setHandle(this, n_i);
+}
+
+// Advance a single slot one step in place, <dt> is this step's time and <p_dt> the previous step's time.
+// Returns through the MOVED flag whether the particle had any velocity.
+void ParticleStore::integrate(unsigned int index, double dt, double p_dt) {
+    double * p = &pos[2 * index];
+    double * pp = &ppos[2 * index];
+
+    double d_x = p[0] - pp[0];
+    double d_y = p[1] - pp[1];
+
+    setFlag(index, MOVED, !(d_x == 0 && d_y == 0));
+
+    // Gravity pulls towards the bottom of the space
+    double a_y = gravity ? -Particle::g_accl : 0;
+
+    pp[0] = p[0];
+    pp[1] = p[1];
+
+    switch (integrator) {
+        case VERLET: {
+            p[0] += d_x;
+            p[1] += d_y + (a_y * dt * dt);
+            break;
+        }
+        case TIME_CORRECTED_VERLET: {
+            double ratio = dt / p_dt;
+            p[0] += d_x * ratio;
+            p[1] += (d_y * ratio) + (a_y * dt * (dt + p_dt) / 2.0);
+            break;
+        }
+    }
+}
+
+// Update the mass, and the cached inverse mass, of a slot
+void ParticleStore::setMass(unsigned int index, double m) {
+    mass[index] = m;
+    inv_mass[index] = m != 0 ? 1.0 / m : 0;
+    mass_generation++;
+}
+
+// Set or clear a flag on a slot
+void ParticleStore::setFlag(unsigned int index, Flag f, bool b) {
+    if(b) {
+        flags[index] |= f;
+    } else {
+        flags[index] &= ~f;
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the header file for the ParticleStore class
+ */
+
+#ifndef FINAL_PROJECT_PARTICLE_STORE_HPP
+#define FINAL_PROJECT_PARTICLE_STORE_HPP
+
+#include <vector>
+
+class Particle;
+
+// ParticleStore holds the physical state of every Particle in a Space in contiguous parallel arrays, so stepping and
+// constraint passes walk linearly through memory instead of chasing each Particle around the heap.  A Particle is
+// only a handle (an index) into its store.  Positions are kept as packed x, y pairs so that a single position can
+// still be handed out as a 2-d array.  Slots are kept dense, removing a particle moves the last slot into its place.
+// A store is not synchronized.  Each Space owns its own, so Spaces can be stepped on different threads, but only one
+// thread may use a given store at a time.
+class ParticleStore {
+public:
+
+    // Per particle flags
+    enum Flag {
+        MOVED = 1 << 0      // The particle had a velocity during its last step
+    };
+
+    // How particles in the store are integrated each step
+    enum Integrator {
+        VERLET,                 // x' = x + (x - px) + a * dt^2, assumes a constant dt
+        TIME_CORRECTED_VERLET   // x' = x + (x - px) * (dt / p_dt) + a * dt * (dt + p_dt) / 2
+    };
+
+protected:
+    std::vector<double> pos;            // x, y pairs
+    std::vector<double> ppos;           // previous x, y pairs
+    std::vector<double> mass;
+    std::vector<double> inv_mass;
+    std::vector<unsigned char> flags;
+    std::vector<Particle*> owners;
+
+    // Bumped whenever a mass is changed, so anything worked out from the masses knows to update
+    unsigned long mass_generation = 0;
+
+    Integrator integrator = TIME_CORRECTED_VERLET;
+    bool gravity = false;
+
+    // Fraction of the way from the previous to the current positions that particles are drawn at
+    double render_alpha = 1;
+
+public:
+
+    ParticleStore();
+    ~ParticleStore();
+
+    // Store that holds particles until they are added under a Space.  Every thread has its own, so worlds can be built
+    // on several threads at once, but a particle has to be added under a Space, or deleted, by the thread that created
+    // it and before that thread exits.
+    static ParticleStore* detached();
+
+    unsigned int size() { return owners.size(); }
+
+    unsigned int add(Particle* owner, double x, double y, double px, double py, double mass);
+    void remove(unsigned int index);
+    void adopt(Particle* p);
+
+    // Integration settings
+    Integrator getIntegrator() { return integrator; }
+    void setIntegrator(Integrator integrator) { this->integrator = integrator; }
+    bool getGravity() { return gravity; }
+    void setGravity(bool b) { this->gravity = b; }
+
+    void integrate(unsigned int index, double dt, double p_dt);
+
+    double getRenderAlpha() { return render_alpha; }
+    void setRenderAlpha(double alpha) { this->render_alpha = alpha; }
+
+    // Single particle access.  Pointers and references into the arrays are only good until the next add(), which can
+    // reallocate them, or remove(), which moves the last slot into the removed one, so they must not be held across
+    // either.
+    double * getPosition(unsigned int index) { return &pos[2 * index]; }
+    double * getPPosition(unsigned int index) { return &ppos[2 * index]; }
+    double getMass(unsigned int index) { return mass[index]; }
+    double getInverseMass(unsigned int index) { return inv_mass[index]; }
+    void setMass(unsigned int index, double m);
+    unsigned long getMassGeneration() { return mass_generation; }
+    bool hasFlag(unsigned int index, Flag f) { return (flags[index] & f) != 0; }
+    void setFlag(unsigned int index, Flag f, bool b);
+    Particle* getOwner(unsigned int index) { return owners[index]; }
+
+    // Bulk access for streaming passes, invalidated the same way as single particle access
+    double * positions() { return pos.data(); }
+    double * previousPositions() { return ppos.data(); }
+    const double * masses() { return mass.data(); }
+    const double * inverseMasses() { return inv_mass.data(); }
+
+};
+
+#endif //FINAL_PROJECT_PARTICLE_STORE_HPP
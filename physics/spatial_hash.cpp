@@ -0,0 +1,185 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the source file for the SpatialHash class
+ */
+
+#include "spatial_hash.hpp"
+#include <cmath>
+#include <algorithm>
+
+// SpatialHash constructor
+// <cell_size> is the width and height of a grid cell in units
+SpatialHash::SpatialHash(double cell_size) {
+    this->cell_size = cell_size;
+}
+
+// Pack the cell coordinates into one hash key.  The coordinates are often negative, so they are packed through unsigned
+// values, shifting a negative value is undefined.
+unsigned long long SpatialHash::key(int c_x, int c_y) const {
+    return ((unsigned long long) (unsigned int) c_x << 32) | (unsigned int) c_y;
+}
+
+// Cell coordinate that a position falls into, clamped to CELL_LIMIT cells either side of the origin so that a position
+// far outside of the Space still converts to an int.  <v> must be finite.
+int SpatialHash::cell(double v) const {
+    double c = std::floor(v / cell_size);
+    return (int) std::max((double) -CELL_LIMIT, std::min((double) CELL_LIMIT, c));
+}
+
+// Remove every shape, the cell vectors are kept so rebuilding does not need to allocate again
+void SpatialHash::clear() {
+    std::unordered_map<unsigned long long, std::vector<unsigned int>>::iterator it;
+    for(it = cells.begin(); it != cells.end(); it++) {
+        it->second.clear();
+    }
+    shapes.clear();
+    slots.clear();
+}
+
+// Index a constraint by its bounding box, constraints without bounds are ignored
+void SpatialHash::insert(SingleConstraint *c) {
+    douglas::Vec2 min;
+    douglas::Vec2 max;
+    if(!c->getBounds(&min, &max) || slots.count(c) != 0) {
+        return;
+    }
+
+    unsigned int slot = shapes.size();
+    shapes.push_back(c);
+    slots[c] = slot;
+
+    int x_max = cell(max.x);
+    int y_max = cell(max.y);
+    for(int x = cell(min.x); x <= x_max; x++) {
+        for(int y = cell(min.y); y <= y_max; y++) {
+            cells[key(x, y)].push_back(slot);
+        }
+    }
+}
+
+// Rebuild the hash from <constraints>
+void SpatialHash::build(const std::vector<SingleConstraint*> &constraints) {
+    clear();
+    for(unsigned int i = 0; i < constraints.size(); i++) {
+        insert(constraints[i]);
+    }
+    candidates.resize(shapes.size());
+    stamps.assign(shapes.size(), 0);
+}
+
+// Cells covered by the path particle <p> took last step, from its previous position to its position.  A path that
+// crosses a shape shares a point, and so a cell, with that shape's bounding box.  A particle that has blown up to a
+// position that is not finite has no cells, it is handed to every shape instead.
+SpatialHash::Box SpatialHash::pathBox(Particle *p) const {
+    const double * pos = p->getStore()->getPosition(p->getIndex());
+    const double * ppos = p->getStore()->getPPosition(p->getIndex());
+    Box box;
+    if(!std::isfinite(pos[0]) || !std::isfinite(pos[1]) || !std::isfinite(ppos[0]) || !std::isfinite(ppos[1])) {
+        box.x_min = box.x_max = box.y_min = box.y_max = 0;
+        box.all = true;
+        return box;
+    }
+    box.x_min = cell(std::min(pos[0], ppos[0]));
+    box.x_max = cell(std::max(pos[0], ppos[0]));
+    box.y_min = cell(std::min(pos[1], ppos[1]));
+    box.y_max = cell(std::max(pos[1], ppos[1]));
+    box.all = false;
+    return box;
+}
+
+// Stamp every shape in the cells of <box> with the current stamp, and when <add> is set also add particle <p> to the
+// candidates of the shapes that were not stamped yet.  A box that covers more cells than are in use is cheaper to hand
+// to every shape, it is marked as <all> when that happens.
+void SpatialHash::visit(Particle *p, Box &box, bool add) {
+    double span = ((double) box.x_max - box.x_min + 1) * ((double) box.y_max - box.y_min + 1);
+    if(box.all || span > cells.size()) {
+        for(unsigned int j = 0; j < shapes.size(); j++) {
+            if(add && stamps[j] != stamp) {
+                candidates[j].push_back(p);
+            }
+            stamps[j] = stamp;
+        }
+        box.all = true;
+        return;
+    }
+    std::unordered_map<unsigned long long, std::vector<unsigned int>>::iterator c_it;
+    for(int x = box.x_min; x <= box.x_max; x++) {
+        for(int y = box.y_min; y <= box.y_max; y++) {
+            c_it = cells.find(key(x, y));
+            if(c_it == cells.end()) {
+                continue;
+            }
+            std::vector<unsigned int> &cell_shapes = c_it->second;
+            for(unsigned int j = 0; j < cell_shapes.size(); j++) {
+                unsigned int slot = cell_shapes[j];
+                if(stamps[slot] != stamp) {
+                    stamps[slot] = stamp;
+                    if(add) {
+                        candidates[slot].push_back(p);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Find, for every indexed shape, which of <particles> it could touch from where they are now
+void SpatialHash::query(const std::vector<Particle*> &particles) {
+    for(unsigned int i = 0; i < shapes.size(); i++) {
+        candidates[i].clear();
+    }
+    boxes.clear();
+    if(shapes.empty()) {
+        return;
+    }
+
+    for(unsigned int i = 0; i < particles.size(); i++) {
+        boxes.push_back(pathBox(particles[i]));
+        stamp++;
+        visit(particles[i], boxes.back(), true);
+    }
+}
+
+// Bring the candidates of the last query up to date after constraints have moved some of <particles>, which must be
+// the same particles in the same order.  A particle whose path has left the cells it was looked up in is added to the
+// shapes of its new cells that it was not already handed to, so the candidates are never missing a shape that a brute
+// force test of every particle would find.  Particles are only ever added, the ones that moved away are left in as
+// testing them is harmless.
+void SpatialHash::refresh(const std::vector<Particle*> &particles) {
+    if(shapes.empty()) {
+        return;
+    }
+
+    for(unsigned int i = 0; i < particles.size() && i < boxes.size(); i++) {
+        Box &old_box = boxes[i];
+        if(old_box.all) {
+            continue;
+        }
+        Box box = pathBox(particles[i]);
+        if(!box.all && box.x_min >= old_box.x_min && box.x_max <= old_box.x_max &&
+           box.y_min >= old_box.y_min && box.y_max <= old_box.y_max) {
+            continue;
+        }
+
+        // Stamp the shapes the particle was already given, then add it to the rest of the grown box
+        stamp++;
+        visit(particles[i], old_box, false);
+        old_box.x_min = std::min(old_box.x_min, box.x_min);
+        old_box.x_max = std::max(old_box.x_max, box.x_max);
+        old_box.y_min = std::min(old_box.y_min, box.y_min);
+        old_box.y_max = std::max(old_box.y_max, box.y_max);
+        old_box.all = box.all;
+        visit(particles[i], old_box, true);
+    }
+}
+
+// Particles from the last query that constraint <c> could touch, or nullptr if <c> is not indexed and should be
+// given every particle
+const std::vector<Particle*>* SpatialHash::getCandidates(SingleConstraint *c) {
+    std::unordered_map<SingleConstraint*, unsigned int>::iterator it = slots.find(c);
+    if(it == slots.end()) {
+        return nullptr;
+    }
+    return &candidates[it->second];
+}
@@ -0,0 +1,72 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the header file for the SpatialHash class
+ */
+
+#ifndef FINAL_PROJECT_SPATIAL_HASH_HPP
+#define FINAL_PROJECT_SPATIAL_HASH_HPP
+
+#include "constraints/single_constraint.hpp"
+#include "particle.hpp"
+#include "../personal_utilities/vec2.hpp"
+#include <unordered_map>
+#include <vector>
+
+// SpatialHash is the broadphase for global constraints.  Constraints that report bounds are put into every cell of a
+// uniform grid that their bounding box covers, and particles are looked up by the box around the path they took last
+// step (previous position to position), so each particle is only handed to the constraints it could actually touch.
+// Constraints without bounds are not indexed and still see every particle.  Other constraints move particles between
+// the query and the indexed constraint that uses it, so refresh() has to be called before the candidates are used
+// once anything may have moved.
+class SpatialHash {
+protected:
+    // Cells a particle was looked up in, <all> when it was handed to every shape instead
+    struct Box {
+        int x_min;
+        int x_max;
+        int y_min;
+        int y_max;
+        bool all;
+    };
+
+    double cell_size;
+
+    std::unordered_map<unsigned long long, std::vector<unsigned int>> cells;
+    std::vector<SingleConstraint*> shapes;
+    std::unordered_map<SingleConstraint*, unsigned int> slots;
+
+    // Per shape particles found by the last query, stamps keep a particle from being added twice to the same shape
+    std::vector<std::vector<Particle*>> candidates;
+    std::vector<unsigned int> stamps;
+    unsigned int stamp = 0;
+
+    // Box of each particle of the last query, in the order they were given
+    std::vector<Box> boxes;
+
+    unsigned long long key(int c_x, int c_y) const;
+    int cell(double v) const;
+    Box pathBox(Particle* p) const;
+    void visit(Particle* p, Box &box, bool add);
+
+public:
+
+    // Cells across the longer side of a Space
+    constexpr static int CELLS_ACROSS = 16;
+    // Furthest cell from the origin in any direction, far enough inside the limits of an int that spans can not overflow
+    constexpr static int CELL_LIMIT = 1 << 24;
+
+    SpatialHash(double cell_size);
+
+    double getCellSize() { return cell_size; }
+
+    void clear();
+    void insert(SingleConstraint* c);
+    void build(const std::vector<SingleConstraint*>& constraints);
+
+    void query(const std::vector<Particle*>& particles);
+    void refresh(const std::vector<Particle*>& particles);
+    const std::vector<Particle*>* getCandidates(SingleConstraint* c);
+};
+
+#endif //FINAL_PROJECT_SPATIAL_HASH_HPP
@@ -0,0 +1,38 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the source file for the SimulationClock class
+ */
+
+#include "simulation_clock.hpp"
+#include <cmath>
+#include <stdexcept>
+
+// Constructor
+// <step> is the seconds of every physics step
+// <max_substeps> is the most steps a single frame can take
+SimulationClock::SimulationClock(double step, unsigned int max_substeps) {
+    if(step <= 0) {
+        throw std::invalid_argument("A simulation step must be longer than zero seconds");
+    }
+    this->step = step;
+    this->max_substeps = max_substeps;
+}
+
+// Add the <elapsed> seconds of a frame and return how many steps to take for it
+unsigned int SimulationClock::advance(double elapsed) {
+    if(elapsed > 0) {
+        accumulator += elapsed;
+    }
+    unsigned int n = (unsigned int) (accumulator / step);
+    if(n > max_substeps) {
+        // Keep only the part of a step that was left over, the rest of the backlog is dropped
+        double keep = std::fmod(accumulator, step);
+        dropped += accumulator - keep - (max_substeps * step);
+        accumulator = keep + (max_substeps * step);
+        n = max_substeps;
+    }
+    accumulator -= n * step;
+    steps += n;
+    return n;
+}
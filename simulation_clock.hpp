@@ -0,0 +1,42 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the header file for the SimulationClock class
+ */
+
+#ifndef FINAL_PROJECT_SIMULATION_CLOCK_HPP
+#define FINAL_PROJECT_SIMULATION_CLOCK_HPP
+
+// SimulationClock turns the time taken by each frame into a whole number of fixed size physics steps, so the physics
+// always steps by the same dt no matter how fast frames are drawn.  Time that does not make a whole step is carried
+// over to the next frame, and how far into the next step that time reaches is the alpha that rendering uses to draw
+// between the previous and current positions.  A frame that would need more than max_substeps steps drops the
+// extra time instead, so one slow frame can not make the next one slower still.
+class SimulationClock {
+protected:
+    double step;
+    unsigned int max_substeps;
+    double accumulator = 0;
+    unsigned long long steps = 0;
+    double dropped = 0;
+
+public:
+
+    SimulationClock(double step, unsigned int max_substeps = 8);
+
+    double getStep() { return step; }
+    void setStep(double step) { this->step = step; }
+    unsigned int getMaxSubsteps() { return max_substeps; }
+    void setMaxSubsteps(unsigned int n) { this->max_substeps = n; }
+
+    unsigned int advance(double elapsed);
+
+    // How far, from 0 to 1, the carried over time is into the next step
+    double getAlpha() { return accumulator / step; }
+    // Steps taken so far
+    unsigned long long getSteps() { return steps; }
+    // Seconds thrown away by the max_substeps clamp so far
+    double getDropped() { return dropped; }
+};
+
+#endif //FINAL_PROJECT_SIMULATION_CLOCK_HPP
@@ -6,11 +6,14 @@
 
 #include "space.hpp"
 #include "physics/constraints/box_constraint.hpp"
+#include "physics/constraints/pair_constraint.hpp"
+#include "trace.hpp"
 #include <iostream>
 #include <string>
 #include <algorithm>
 
-std::string Space::TYPE = "space";
+TypeId Space::TYPE = Typed::registerType("space");
+unsigned long Space::n_background_key = 0;
 
 // Space Constructor with unit width and unit height
 Space::Space(double u_w, double u_h) : GameObject() {
@@ -18,6 +21,10 @@ Space::Space(double u_w, double u_h) : GameObject() {
     unit_width = u_w;
     unit_height = u_h;
 
+    // The store has to exist before any children are added as they are adopted into it
+    particle_store = new ParticleStore();
+    broadphase = new SpatialHash(std::max(u_w, u_h) / SpatialHash::CELLS_ACROSS);
+
     physics = new ParticleContainer();
     physics->setParent(this);
     addChild(physics);
@@ -26,59 +33,304 @@ Space::Space(double u_w, double u_h) : GameObject() {
     physics->addSubGlobalConstraint(boundary);
 }
 
-// Default space deconstructor
-Space::~Space() {}
+// Space deconstructor, the children still hold handles into the particle store so they are deleted before it
+Space::~Space() {
+    std::vector<GameObject*>::iterator it;
+    for(it = children.begin(); it != children.end(); it++) {
+        delete (*it);
+    }
+    children.clear();
+    delete particle_store;
+    delete broadphase;
+}
 
 // Handle the physics of the simulation
 void Space::handlePhysics(int t_iter) {
+    Trace::Scope trace("handlePhysics", getType());
+
+    const std::vector<ParticleContainer*> &c_pcs = getContainers();
+
+    // Only constraints that never move are indexed, so the broadphase is only rebuilt when the constraints change
+    if(broadphase_generation != constraint_generation) {
+        std::vector<SingleConstraint*> globals;
+        physics->getSuperGlobalConstraints(&globals);
+        for(unsigned int i = 0; i < c_pcs.size(); i++) {
+            c_pcs[i]->getSubGlobalConstraints(&globals);
+        }
+        broadphase->build(globals);
+        broadphase_generation = constraint_generation;
+    }
 
     for(int i = 0; i < t_iter; i++) {
 
-        std::vector<GameObject*> c_pcs;
-        getChildrenOfType(ParticleContainer::TYPE, &c_pcs);
-        std::vector<GameObject*>::iterator it;
-        for(it = c_pcs.begin(); it != c_pcs.end(); it++) {
-            ((ParticleContainer*) *it)->handleConstraints( i + 1 );
+        if(solver_pool == nullptr && !batched_lines) {
+            for(unsigned int j = 0; j < c_pcs.size(); j++) {
+                c_pcs[j]->handleConstraints( i + 1 );
+            }
+        } else {
+            // Batched lines and islands first, then the global constraints that can reach across islands one container
+            // at a time
+            solveSpecificConstraints( i + 1 );
+            for(unsigned int j = 0; j < c_pcs.size(); j++) {
+                c_pcs[j]->handleGlobalConstraints( i + 1 );
+            }
         }
 
     }
 
 }
 
-// Respond to new child by requesting updating of the physics element's super global constraint master cache
+// Solve the specific constraints of every container, batched lines first, then islands across the solver pool and
+// the rest in tree order
+void Space::solveSpecificConstraints(int iter) {
+    if(islands_generation != constraint_generation || !line_batch.refresh()) {
+        buildIslands();
+    }
+
+    if(line_batch.size() > 0) {
+        Trace::Scope trace("solveLines", LineConstraint::TYPE);
+        line_batch.solve(solver_pool);
+    }
+
+    // Small islands are handed out in chunks so each task has enough work to be worth scheduling
+    unsigned int chunks = 1;
+    if(solver_pool != nullptr) {
+        chunks = std::min((unsigned int) islands.size(), (solver_pool->size() + 1) * 4);
+    }
+    if(chunks > 1) {
+        unsigned int per_chunk = (islands.size() + chunks - 1) / chunks;
+        solver_pool->parallelFor(chunks, [this, iter, per_chunk](unsigned int c) {
+            unsigned int end = std::min((unsigned int) islands.size(), (c + 1) * per_chunk);
+            for(unsigned int i = c * per_chunk; i < end; i++) {
+                for(unsigned int j = 0; j < islands[i].size(); j++) {
+                    Trace::Scope trace("fix", islands[i][j]->getType());
+                    islands[i][j]->fix(iter);
+                }
+            }
+        });
+    } else {
+        for(unsigned int i = 0; i < islands.size(); i++) {
+            for(unsigned int j = 0; j < islands[i].size(); j++) {
+                Trace::Scope trace("fix", islands[i][j]->getType());
+                islands[i][j]->fix(iter);
+            }
+        }
+    }
+
+    for(unsigned int i = 0; i < serial_constraints.size(); i++) {
+        Trace::Scope trace("fix", serial_constraints[i]->getType());
+        serial_constraints[i]->fix(iter);
+    }
+}
+
+// Find root of a particle slot in the union find forest, flattening the path on the way up
+static unsigned int findIsland(std::vector<unsigned int> &roots, unsigned int i) {
+    while(roots[i] != i) {
+        roots[i] = roots[roots[i]];
+        i = roots[i];
+    }
+    return i;
+}
+
+// Group the specific constraints into islands, the connected components of the pair constraint graph.  Pair
+// constraints only move the two particles they join, so constraints in different islands never touch the same
+// particle.  Other constraints can reach any particle, or a particle in another Space, so they are kept serial.
+// With batched_lines set the EQUAL line constraints are taken out first and packed into the LineBatch instead.
+void Space::buildIslands() {
+    islands.clear();
+    serial_constraints.clear();
+    std::vector<LineConstraint*> lines;
+
+    std::vector<Constraint*> specifics;
+    const std::vector<ParticleContainer*> &c_pcs = getContainers();
+    for(unsigned int i = 0; i < c_pcs.size(); i++) {
+        c_pcs[i]->getSpecificConstraints(&specifics);
+    }
+
+    std::vector<unsigned int> roots(particle_store->size());
+    for(unsigned int i = 0; i < roots.size(); i++) {
+        roots[i] = i;
+    }
+
+    std::vector<Constraint*> pairs;
+    for(unsigned int i = 0; i < specifics.size(); i++) {
+        Constraint* c = specifics[i];
+        if(batched_lines && LineBatch::canBatch(c, particle_store)) {
+            lines.push_back((LineConstraint*) c);
+            continue;
+        }
+        std::vector<Particle*> c_particles = c->getParticles();
+        bool local = c->isType(PairConstraint::TYPE) && !c_particles.empty();
+        for(unsigned int j = 0; local && j < c_particles.size(); j++) {
+            local = c_particles[j] != nullptr && c_particles[j]->getStore() == particle_store;
+        }
+        if(!local) {
+            serial_constraints.push_back(c);
+            continue;
+        }
+        unsigned int root = findIsland(roots, c_particles[0]->getIndex());
+        for(unsigned int j = 1; j < c_particles.size(); j++) {
+            unsigned int other = findIsland(roots, c_particles[j]->getIndex());
+            roots[other] = root;
+        }
+        pairs.push_back(c);
+    }
+
+    // Keep the constraints of each island in tree order, islands are numbered by their first constraint
+    std::vector<int> island_of(roots.size(), -1);
+    for(unsigned int i = 0; i < pairs.size(); i++) {
+        unsigned int root = findIsland(roots, pairs[i]->getParticles()[0]->getIndex());
+        if(island_of[root] < 0) {
+            island_of[root] = islands.size();
+            islands.push_back(std::vector<Constraint*>());
+        }
+        islands[island_of[root]].push_back(pairs[i]);
+    }
+
+    if(lines.empty()) {
+        line_batch.clear();
+    } else {
+        line_batch.build(lines, particle_store);
+    }
+
+    islands_generation = constraint_generation;
+}
+
+// Step everything under the Space along by walking the flat traversal list instead of recursing through the tree
+void Space::stepChildren(double dt) {
+    refreshTraversal();
+    for(unsigned int i = 0; i < traversal.size(); i++) {
+        traversal[i]->update(dt);
+    }
+}
+
+// Rebuild the flat traversal, container and particle lists if the tree has changed since they were last built
+void Space::refreshTraversal() {
+    if(traversal_generation == topology_generation) {
+        return;
+    }
+
+    traversal.clear();
+    containers.clear();
+    particles.clear();
+
+    // Every object is a GameObject, the first one found is the Space itself
+    getChildrenOfType(GameObject::TYPE, &traversal);
+    traversal.erase(traversal.begin());
+
+    for(unsigned int i = 0; i < traversal.size(); i++) {
+        if(traversal[i]->isType(ParticleContainer::TYPE)) {
+            containers.push_back((ParticleContainer*) traversal[i]);
+        }
+        if(traversal[i]->isType(Particle::TYPE)) {
+            particles.push_back((Particle*) traversal[i]);
+        }
+    }
+
+    traversal_generation = topology_generation;
+}
+
+// Respond to new child by invalidating the cached global constraint lists, and moving any particles under it into
+// this space's particle store
 void Space::newChild(GameObject *child) {
-    physics->getSuperGlobalConstraints(nullptr, true);
+    constraintsChanged();
+    topology_generation++;
+
+    std::vector<GameObject*> particles;
+    child->getChildrenOfType(Particle::TYPE, &particles);
+    std::vector<GameObject*>::iterator it;
+    for(it = particles.begin(); it != particles.end(); it++) {
+        particle_store->adopt((Particle*) *it);
+    }
 }
 
-// Convert point in units to point in pixels
-double* Space::convertToPixels(const double x, const double y, Screen* screen) {
-    double x_ppu = screen->getWidth() / unit_width;
-    double y_ppu = screen->getHeight() / unit_height;
-    double* output = new double[2];
-    output[0] = x * x_ppu;
-    output[1] = y * y_ppu;
-    return output;
+// Respond to a removed child by invalidating the cached global constraint lists and traversal lists, anything in
+// the background is drawn by itself again
+void Space::removedChild(GameObject *child) {
+    constraintsChanged();
+    topology_generation++;
+
+    std::vector<GameObject*> removed;
+    child->getChildrenOfType(GameObject::TYPE, &removed);
+    for(unsigned int i = 0; i < removed.size(); i++) {
+        removed[i]->setBaked(false);
+    }
 }
 
-// Convert point in units to point in pixels
+// Make the background the one <screen> starts its frames from, drawing it again first if the tree or the screen size
+// has changed since it was last drawn.  Anything drawn in the frame before this is lost when the screen's background
+// changes, so a Space calls this before drawing anything else.
+void Space::drawBackground(Screen *screen) {
+    if(background_generation == topology_generation && background_width == screen->getWidth() &&
+       background_height == screen->getHeight()) {
+        screen->setBackground(background, background_key);
+        return;
+    }
+
+    background.clear();
+    renderBackground(screen, &background);
+    const std::vector<GameObject*> &objects = getTraversal();
+    for(unsigned int i = 0; i < objects.size(); i++) {
+        if(objects[i]->isStatic()) {
+            objects[i]->renderStatic(screen, &background);
+            objects[i]->setBaked(true);
+        }
+    }
+
+    background_key = ++n_background_key;
+    background_generation = topology_generation;
+    background_width = screen->getWidth();
+    background_height = screen->getHeight();
+    screen->setBackground(background, background_key);
+}
+
+// Render every child that is not part of the background on top of it
+void Space::renderChildren(Screen *screen) {
+    drawBackground(screen);
+    GameObject::renderChildren(screen);
+}
+
+// Convert point in units to point in pixels, in place
 void Space::convertToPixels(double * x, double * y, Screen* screen) {
-    double* output = convertToPixels(*x, *y, screen);
-    *x = output[0];
-    *y = output[1];
-    delete [] output;
+    refreshViewport(screen);
+    *x *= viewport.x_ppu;
+    *y *= viewport.y_ppu;
 }
 
-// Convert point in units to point in pixels
+// Convert point in units to point in pixels, in place
 void Space::convertToPixels(double *pos, Screen *screen) {
     convertToPixels(&pos[0], &pos[1], screen);
 }
 
 // Convert point in units to point in pixels
-double* Space::convertToPixels(const double *pos, Screen *screen) {
-    return convertToPixels(pos[0], pos[1], screen);
+douglas::Vec2 Space::convertToPixels(const douglas::Vec2 &pos, Screen *screen) {
+    refreshViewport(screen);
+    return douglas::Vec2(pos.x * viewport.x_ppu, pos.y * viewport.y_ppu);
 }
 
 // Convert point in units to point in pixels
-double* Space::convertToPixels(Particle *p, Screen *screen) {
-    return convertToPixels((*p)[0], (*p)[1], screen);
+douglas::Vec2 Space::convertToPixels(Particle *p, Screen *screen) {
+    return convertToPixels(p->getRenderPosition(), screen);
+}
+
+// Convert where each of <n> particles is drawn to pixels, adding them to the end of <out> in the same order
+void Space::convertToPixels(Particle * const * particles, unsigned int n, std::vector<douglas::Vec2> *out,
+                            Screen *screen) {
+    if(n == 0) {
+        return;
+    }
+    refreshViewport(screen);
+    unsigned int first = out->size();
+    out->resize(first + n);
+    douglas::Vec2* points = &(*out)[first];
+    for(unsigned int k = 0; k < n; k++) {
+        points[k] = particles[k]->getRenderPosition();
+    }
+    // Scaled in a second pass over the packed points so the loop has no calls in it and can be vectorized
+    const double x_ppu = viewport.x_ppu;
+    const double y_ppu = viewport.y_ppu;
+    for(unsigned int k = 0; k < n; k++) {
+        points[k].x *= x_ppu;
+        points[k].y *= y_ppu;
+    }
 }
\ No newline at end of file
@@ -9,8 +9,13 @@
 
 #include "game_object.hpp"
 #include "physics/particle_container.hpp"
+#include "physics/particle_store.hpp"
+#include "physics/spatial_hash.hpp"
+#include "physics/line_batch.hpp"
 #include "physics/constraints/box_constraint.hpp"
 #include "display/screen.hpp"
+#include "personal_utilities/vec2.hpp"
+#include "personal_utilities/thread_pool.hpp"
 #include <string>
 #include <vector>
 
@@ -20,14 +25,73 @@ protected:
     double unit_width;
     double unit_height;
     ParticleContainer* physics;
+    ParticleStore* particle_store;
+    SpatialHash* broadphase;
+    bool use_broadphase = true;
     BoxConstraint* boundary;
     void handlePhysics(int);
 
+    // Bumped whenever the tree or the global constraints under this Space change, so caches know to rebuild
+    unsigned long constraint_generation = 1;
+    unsigned long broadphase_generation = 0;
+
+    // Everything under the Space in the order a recursive walk would visit it, rebuilt only when the tree changes
+    unsigned long topology_generation = 1;
+    unsigned long traversal_generation = 0;
+    std::vector<GameObject*> traversal;
+    std::vector<ParticleContainer*> containers;
+    std::vector<Particle*> particles;
+    void refreshTraversal();
+
+    // Specific constraints split into islands, pair constraints that share no particles with any other island, so
+    // islands can be solved at the same time.  Every other specific constraint is solved afterwards one at a time.
+    ThreadPool* solver_pool = nullptr;
+    unsigned long islands_generation = 0;
+    std::vector<std::vector<Constraint*>> islands;
+    std::vector<Constraint*> serial_constraints;
+    // EQUAL line constraints packed together and solved ahead of the islands when batched_lines is set
+    bool batched_lines = false;
+    LineBatch line_batch;
+    void buildIslands();
+    void solveSpecificConstraints(int iter);
+
+    void stepChildren(double dt);
+
+    // Pixels of everything under the Space that never moves, drawn once for each tree layout and screen size and
+    // handed to the screen as the background that frames start from.  Rooms add their own fixed decorations through
+    // renderBackground.  background_key is new every time the pixels are drawn again.
+    std::vector<Pixel> background;
+    unsigned long background_key = 0;
+    unsigned long background_generation = 0;
+    int background_width = -1;
+    int background_height = -1;
+    static unsigned long n_background_key;
+    void drawBackground(Screen* screen);
+    virtual void renderBackground(Screen* screen, std::vector<Pixel>* vec) {}
+    void renderChildren(Screen* screen);
+
+    // Pixels per unit on the screen last converted for, worked out again only when the screen size changes
+    struct Viewport {
+        int width;
+        int height;
+        double x_ppu;
+        double y_ppu;
+    };
+    Viewport viewport = { -1, -1, 0, 0 };
+    void refreshViewport(Screen* screen) {
+        if(screen->getWidth() != viewport.width || screen->getHeight() != viewport.height) {
+            viewport.width = screen->getWidth();
+            viewport.height = screen->getHeight();
+            viewport.x_ppu = viewport.width / unit_width;
+            viewport.y_ppu = viewport.height / unit_height;
+        }
+    }
+
     Space* neighbors[4];
 
 public:
 
-    static std::string TYPE;
+    static TypeId TYPE;
 
     Space(double u_w, double u_h);
     ~Space();
@@ -38,14 +102,39 @@ public:
     double getHeight() { return unit_height; }
 
     void convertToPixels(double * pos, Screen* screen);
-    double * convertToPixels(const double * pos, Screen* screen);
-    double * convertToPixels(const double x, const double y, Screen* screen);
     void convertToPixels(double *x, double *y, Screen* screen);
-    double * convertToPixels(Particle * p, Screen* screen);
+    douglas::Vec2 convertToPixels(const douglas::Vec2 &pos, Screen* screen);
+    douglas::Vec2 convertToPixels(Particle * p, Screen* screen);
+    void convertToPixels(Particle * const * particles, unsigned int n, std::vector<douglas::Vec2>* out, Screen* screen);
 
     ParticleContainer* getPhysics() { return physics; }
 
+    // Pool that constraint islands are solved on, nullptr solves everything in tree order on the calling thread
+    ThreadPool* getSolverPool() { return solver_pool; }
+    void setSolverPool(ThreadPool* pool) { this->solver_pool = pool; }
+    // Whether EQUAL line constraints are solved as a LineBatch, in color order instead of tree order
+    bool getBatchedLines() { return batched_lines; }
+    void setBatchedLines(bool b) { this->batched_lines = b; constraintsChanged(); }
+    LineBatch* getLineBatch() { return &line_batch; }
+    ParticleStore* getParticleStore() { return particle_store; }
+    // Fraction of a step between the previous and current positions that the particles in the Space are drawn at
+    double getRenderAlpha() { return particle_store->getRenderAlpha(); }
+    void setRenderAlpha(double alpha) { particle_store->setRenderAlpha(alpha); }
+    // Broadphase for the global constraints, nullptr when it is turned off and every particle is tested by brute force
+    SpatialHash* getBroadphase() { return use_broadphase ? broadphase : nullptr; }
+    bool getUseBroadphase() { return use_broadphase; }
+    void setUseBroadphase(bool b) { this->use_broadphase = b; }
+
     void newChild(GameObject* child);
+    void removedChild(GameObject* child);
+
+    unsigned long getConstraintGeneration() { return constraint_generation; }
+    void constraintsChanged() { constraint_generation++; }
+    unsigned long getTopologyGeneration() { return topology_generation; }
+
+    const std::vector<GameObject*>& getTraversal() { refreshTraversal(); return traversal; }
+    const std::vector<ParticleContainer*>& getContainers() { refreshTraversal(); return containers; }
+    const std::vector<Particle*>& getParticles() { refreshTraversal(); return particles; }
 
     // Handle neighbor getting and setting
     // Indexed starting from the top (0) going clockwise until the left (3)
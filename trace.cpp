@@ -0,0 +1,135 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the source file for the Trace class
+ */
+
+#include "trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+constexpr TypeId Trace::NO_TYPE;
+constexpr unsigned int Trace::RING_SIZE;
+
+std::atomic<bool> Trace::enabled(false);
+thread_local Trace::Ring* Trace::ring = nullptr;
+std::mutex Trace::rings_lock;
+
+// Every ring ever made, held in a function so it exists before anything is traced during start up.  Rings outlive
+// their threads so the events of a finished thread can still be dumped.
+std::vector<std::unique_ptr<Trace::Ring>>& Trace::rings() {
+    static std::vector<std::unique_ptr<Ring>> all;
+    return all;
+}
+
+// The current thread's ring, made the first time the thread records an event
+Trace::Ring* Trace::threadRing() {
+    if(ring == nullptr) {
+        std::lock_guard<std::mutex> guard(rings_lock);
+        rings().push_back(std::unique_ptr<Ring>(new Ring(rings().size())));
+        ring = rings().back().get();
+    }
+    return ring;
+}
+
+// Nanoseconds on a steady clock
+unsigned long long Trace::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Add an event to the current thread's ring
+// <name> must outlive the trace, a string literal
+// <type> is the type the time is recorded against, or NO_TYPE
+// <start> and <end> are from Trace::now()
+void Trace::record(const char * name, TypeId type, unsigned long long start, unsigned long long end) {
+    Ring* r = threadRing();
+    unsigned long long h = r->head.load(std::memory_order_relaxed);
+    Event &e = r->events[h % RING_SIZE];
+    e.name = name;
+    e.type = type;
+    e.start = start;
+    e.end = end;
+    // Published after the event is written so a dump never reads a half written event that it thinks is done
+    r->head.store(h + 1, std::memory_order_release);
+}
+
+// Forget every event recorded so far.  Must not be called while other threads are recording.
+void Trace::clear() {
+    std::lock_guard<std::mutex> guard(rings_lock);
+    for(unsigned int i = 0; i < rings().size(); i++) {
+        rings()[i]->head = 0;
+    }
+}
+
+// Write every event still in the rings as Chrome trace JSON.  A thread can keep recording while this runs, any event
+// it overwrites during the copy is left out.
+void Trace::dump(std::ostream &out) {
+    struct Copied {
+        Event event;
+        unsigned int thread;
+    };
+    std::vector<Copied> copied;
+    unsigned int threads;
+    {
+        std::lock_guard<std::mutex> guard(rings_lock);
+        threads = rings().size();
+        for(unsigned int i = 0; i < rings().size(); i++) {
+            Ring* r = rings()[i].get();
+            unsigned long long end = r->head.load(std::memory_order_acquire);
+            unsigned long long begin = end > RING_SIZE ? end - RING_SIZE : 0;
+            std::vector<Event> events;
+            for(unsigned long long k = begin; k < end; k++) {
+                events.push_back(r->events[k % RING_SIZE]);
+            }
+            // Anything the writer has reached since the copy started may have been overwritten
+            unsigned long long now_end = r->head.load(std::memory_order_acquire);
+            unsigned long long valid = now_end > RING_SIZE ? now_end - RING_SIZE : 0;
+            for(unsigned long long k = std::max(begin, valid); k < end; k++) {
+                Copied c = { events[k - begin], r->thread };
+                copied.push_back(c);
+            }
+        }
+    }
+
+    unsigned long long origin = ~0ull;
+    for(unsigned int i = 0; i < copied.size(); i++) {
+        origin = std::min(origin, copied[i].event.start);
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for(unsigned int t = 0; t < threads; t++) {
+        out << (first ? "" : ",") << std::endl
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t
+            << ",\"args\":{\"name\":\"thread " << t << "\"}}";
+        first = false;
+    }
+    char times[64];
+    for(unsigned int i = 0; i < copied.size(); i++) {
+        const Event &e = copied[i].event;
+        out << (first ? "" : ",") << std::endl << "{\"name\":\"" << e.name;
+        if(e.type != NO_TYPE) {
+            out << " " << Typed::typeName(e.type);
+        }
+        // Chrome traces are in microseconds
+        std::snprintf(times, sizeof(times), "%.3f,\"dur\":%.3f", (e.start - origin) / 1000.0,
+                      (e.end - e.start) / 1000.0);
+        out << "\",\"cat\":\"" << e.name << "\",\"ph\":\"X\",\"ts\":" << times
+            << ",\"pid\":1,\"tid\":" << copied[i].thread << "}";
+        first = false;
+    }
+    out << std::endl << "]}" << std::endl;
+}
+
+// Write the trace to the file at <path>
+void Trace::dump(const std::string &path) {
+    std::ofstream file(path.c_str());
+    if(!file) {
+        throw std::runtime_error("Could not open trace file " + path);
+    }
+    dump(file);
+}
@@ -0,0 +1,88 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the header file for the Trace class
+ */
+
+#ifndef FINAL_PROJECT_TRACE_HPP
+#define FINAL_PROJECT_TRACE_HPP
+
+#include "typed.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Trace records how long the hot parts of a frame take so a slow frame can be pinned on a room or a constraint type.
+// Every thread writes to its own ring buffer, so recording never takes a lock or waits on another thread, and the
+// oldest events are overwritten once a ring is full.  The rings can be dumped as Chrome trace JSON and opened in
+// chrome://tracing or Perfetto.  While tracing is off a Scope costs a single atomic load.
+class Trace {
+public:
+    // Type given to events that are not about a Typed object
+    constexpr static TypeId NO_TYPE = ~0u;
+    // Events kept for each thread
+    constexpr static unsigned int RING_SIZE = 1 << 16;
+
+    // Times the code from its construction to the end of its scope
+    class Scope {
+        const char * name;
+        TypeId type;
+        unsigned long long start;
+        bool active;
+    public:
+        // <name> must outlive the trace, a string literal
+        // <type> is the type the time is recorded against, such as the room or constraint being worked on
+        Scope(const char * name, TypeId type = NO_TYPE) : name(name), type(type), start(0),
+                                                          active(Trace::isEnabled()) {
+            if(active) {
+                start = Trace::now();
+            }
+        }
+        ~Scope() {
+            if(active) {
+                Trace::record(name, type, start, Trace::now());
+            }
+        }
+        Scope(const Scope &obj) = delete;
+        Scope &operator =(const Scope &obj) = delete;
+    };
+
+private:
+    struct Event {
+        const char * name;
+        TypeId type;
+        unsigned long long start;
+        unsigned long long end;
+    };
+
+    // Only its own thread writes to a ring, head is the count of events ever written to it
+    struct Ring {
+        std::vector<Event> events;
+        std::atomic<unsigned long long> head;
+        unsigned int thread;
+        Ring(unsigned int thread) : events(RING_SIZE), head(0), thread(thread) {}
+    };
+
+    static std::atomic<bool> enabled;
+    static thread_local Ring* ring;
+    static std::mutex rings_lock;
+    static std::vector<std::unique_ptr<Ring>>& rings();
+
+    static Ring* threadRing();
+
+public:
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool on) { enabled = on; }
+
+    static unsigned long long now();
+    static void record(const char * name, TypeId type, unsigned long long start, unsigned long long end);
+    static void clear();
+
+    static void dump(std::ostream &out);
+    static void dump(const std::string &path);
+};
+
+#endif //FINAL_PROJECT_TRACE_HPP
@@ -0,0 +1,30 @@
+/**
+ * Author:      Brennan Douglas
+ * Date:        10/17/2026
+ * Description: This is the source file for the Typed class
+ */
+
+#include "typed.hpp"
+#include <stdexcept>
+
+// Names of every registered type, indexed by TypeId.  Held in a function so it exists before any TYPE in another
+// file is registered during start up.
+std::vector<std::string>& Typed::registry() {
+    static std::vector<std::string> names;
+    return names;
+}
+
+// Give a type name its id, registering the same name twice gives back the same id
+TypeId Typed::registerType(const std::string &name) {
+    std::vector<std::string> &names = registry();
+    for(unsigned int i = 0; i < names.size(); i++) {
+        if(names[i] == name) {
+            return i;
+        }
+    }
+    if(names.size() >= MAX_TYPES) {
+        throw std::length_error("Too many types registered");
+    }
+    names.push_back(name);
+    return names.size() - 1;
+}
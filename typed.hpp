@@ -7,22 +7,38 @@
 #ifndef FINAL_PROJECT_TYPED_HPP
 #define FINAL_PROJECT_TYPED_HPP
 
-#include <vector>
-#include <algorithm>
+#include <bitset>
 #include <string>
+#include <vector>
 
-// This class allows for all the types a derived class is to be easily determined through defined TYPE stings in
-// each of the super classes.
+// Small integer handed out for each type name by Typed::registerType
+typedef unsigned int TypeId;
+
+// This class allows for all the types a derived class is to be easily determined through defined TYPE ids in
+// each of the super classes.  Each TYPE is registered once at start up, after that an object's types are a bitset so
+// checking a type is a single bit test instead of comparing strings.
 class Typed {
+public:
+    // Most distinct types that can be registered
+    constexpr static unsigned int MAX_TYPES = 64;
+
+private:
+    static std::vector<std::string>& registry();
+
 protected:
-    std::vector<std::string> types;
+    std::bitset<MAX_TYPES> types;
+    TypeId type;
 public:
-    Typed(std::string type) { types.push_back(type); }
+    Typed(TypeId type) : type(type) { types.set(type); }
     virtual ~Typed() {};
 
-    void addType(std::string type) { types.push_back(type); }
-    std::string getType() { return types[types.size() - 1]; }
-    bool isType(std::string type) { return std::find(types.begin(), types.end(), type) != types.end(); }
+    static TypeId registerType(const std::string& name);
+    static const std::string& typeName(TypeId id) { return registry()[id]; }
+
+    void addType(TypeId type) { types.set(type); this->type = type; }
+    TypeId getType() { return type; }
+    const std::string& getTypeName() { return typeName(type); }
+    bool isType(TypeId type) { return types.test(type); }
 };
 
 #endif //FINAL_PROJECT_TYPED_HPP